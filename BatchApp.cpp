@@ -0,0 +1,468 @@
+/******************************************************************
+ *
+ * File: BatchApp.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Batch driver for running one algorithm over a grid of problems,
+ * population sizes and numbers of generations in a single process. Each
+ * problem is read once and the runs are spread over a thread pool. One
+ * line of results is written to the console per run, as csv or json.
+ *
+ *     ./BatchApp [data folder] [files] [problems] [algorithm]
+ *         [algorithm modifications] [population sizes] [# of generations]
+ *         [threads] [csv|json] [seed] [algorithm specific parameters]
+ *
+ * Lists are comma separated and may hold ranges, ex. I01,I02 or 1-30,
+ * problems are ignored for orlib_data. threads 0 uses every core, seed 0
+ * draws a fresh seed. Budgets for every run, ex. time=10 evals=50000
+ * target=3900 stagnation=20, may follow the algorithm specific parameters.
+ *
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdlib.h> //atoi
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+#include "MMKPDataSet.h"
+#include "MMKPBinary.h"
+#include "MMKPReduction.h"
+#include "MMKPSolution.h"
+#include "MMKPPopulationGenerators.h"
+#include "MMKPRandom.h"
+#include "MMKP_ABC.h"
+#include "MMKP_ACO.h"
+#include "MMKP_BBA.h"
+#include "MMKP_COA.h"
+#include "MMKP_GA.h"
+#include "MMKP_TLBO.h"
+#include "MMKP_LocalSearch.h"
+#include "MMKP_PSO.h"
+#include "ThreadPool.h"
+
+/**
+ * A problem read once and shared (read only) by all runs on it.
+ */
+typedef struct{
+    std::string file;
+    int problem;
+    MMKPDataSet dataSet;
+}BatchProblem;
+
+/**
+ * One point of the grid.
+ */
+typedef struct{
+    int problem;                //index into the problems read
+    int populationSize;
+    int numberOfGenerations;
+    unsigned long long seed;
+}BatchRun;
+
+/**
+ * Split a comma separated list.
+ */
+static std::vector<std::string> splitList(const std::string& list){
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while(std::getline(stream,item,',')){
+        if(!item.empty()){
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * Parse a comma separated list of numbers and ranges, ex. 1-5,10.
+ */
+static std::vector<int> parseNumbers(const std::string& list){
+    std::vector<int> numbers;
+    std::vector<std::string> items = splitList(list);
+    for(std::size_t i=0;i<items.size();i++){
+        std::size_t dash = items[i].find('-',1);
+        if(dash == std::string::npos){
+            numbers.push_back(atoi(items[i].c_str()));
+        }else{
+            int first = atoi(items[i].substr(0,dash).c_str());
+            int last = atoi(items[i].substr(dash+1).c_str());
+            for(int n=first;n<=last;n++){
+                numbers.push_back(n);
+            }
+        }
+    }
+    return numbers;
+}
+
+/**
+ * Read a problem, from the binary file (see MMKPConvert) when there is
+ * one. Returns an empty MMKPDataSet on failure.
+ */
+static MMKPDataSet readProblem(const std::string& folder, const std::string& file,
+                               int problem){
+    MMKPBinary_Read readBinary;
+    MMKPDataSet dataSet = readBinary(folder+std::string("/")+file+
+                                     MMKP_BINARY_EXTENSION,problem);
+    if(dataSet.size() != 0){
+        return dataSet;
+    }
+    std::ifstream fileStream((folder+std::string("/")+file).c_str());
+    if(!fileStream.is_open()){
+        return dataSet;
+    }
+    if(folder=="orlib_data"){
+        OrLib_Read readInput;
+        dataSet = readInput(fileStream);
+    }else{
+        HiremathHill_Read readInput;
+        dataSet = readInput(fileStream,problem,folder+std::string("/")+file);
+    }
+    fileStream.close();
+    return dataSet;
+}
+
+/**
+ * Return the number of algorithm specific parameters alg takes, -1 if
+ * the algorithm is not recognized. tlbo and aco take one more, optional,
+ * for the number of threads.
+ */
+static int getNumberOfParameters(const std::string& alg){
+    if(alg=="aco"){return 3;}
+    if((alg=="coa") || (alg=="ga") || (alg=="tlbo")){return 2;}
+    if(alg=="pso"){return 1;}
+    if((alg=="bba") || (alg=="abc")){return 0;}
+    return -1;
+}
+
+/**
+ * Build the algorithm for one run, as HeuristicApp does, with the budgets
+ * of param: budgets. The caller seeds it (see MMKP_MetaHeuristic::setRandom).
+ */
+static MMKP_MetaHeuristic* createAlgorithm(const std::string& alg,
+        const MMKPDataSet& dataSet, const std::string& mods,
+        const BatchRun& run, const std::vector<std::string>& params,
+        const MetaHeuristic_parameters& budgets){
+    if(alg=="aco"){
+        ACO_parameters parameters;
+        parameters.B = atof(params[0].c_str());
+        parameters.p = atof(params[1].c_str());
+        parameters.e = atof(params[2].c_str());
+        if(params.size() > 3){
+            parameters.numberOfThreads = atoi(params[3].c_str());
+        }
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_ACO(dataSet,parameters);
+    }else if(alg=="coa"){
+        COA_parameters parameters;
+        parameters.horizCrossProb = atof(params[0].c_str());
+        parameters.verticalCrossProb = atof(params[1].c_str());
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_COA(dataSet,parameters);
+    }else if(alg=="bba"){
+        BBA_parameters parameters;
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_BBA(dataSet,parameters);
+    }else if(alg=="ga"){
+        GA_parameters parameters;
+        parameters.parentPoolSizeT = atoi(params[0].c_str());
+        parameters.mutateProb = atof(params[1].c_str());
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_GA(dataSet,parameters);
+    }else if(alg=="abc"){
+        ABC_parameters parameters;
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_ABC(dataSet,parameters);
+    }else if(alg=="pso"){
+        PSO_parameters parameters;
+        parameters.learningFactor = atof(params[0].c_str());
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_PSO(dataSet,parameters);
+    }else if(alg=="tlbo"){
+        TLBO_parameters parameters;
+        parameters.alg_Type = atof(params[0].c_str());
+        parameters.rls_on = atof(params[1].c_str());
+        if(params.size() > 2){
+            parameters.numberOfThreads = atoi(params[2].c_str());
+        }
+        parameters.numberOfGenerations = run.numberOfGenerations;
+        parameters.populationSize = run.populationSize;
+        parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+        parameters.multipleDimFeasibilityMod = mods[2] - '0';
+        parameters.setBudgets(budgets);
+        return new MMKP_TLBO(dataSet,parameters);
+    }
+    return NULL;
+}
+
+int main(int argc, char* argv[]){
+    
+    if(argc < 11){
+        std::cout<<"usage: BatchApp <folder><files><problems><alg><mods>"
+            <<"<popSizes><genSizes><threads><csv|json><seed>[<alg params>]"
+            <<"[time=<s>][evals=<n>][target=<profit>][stagnation=<gens>]\n";
+        return 0;
+    }
+    std::string folder = argv[1];
+    std::vector<std::string> files = splitList(argv[2]);
+    std::vector<int> problemNumbers = parseNumbers(argv[3]);
+    std::string alg = argv[4];
+    std::string mods = argv[5];
+    std::vector<int> popSizes = parseNumbers(argv[6]);
+    std::vector<int> genSizes = parseNumbers(argv[7]);
+    int numberOfThreads = atoi(argv[8]);
+    std::string format = argv[9];
+    unsigned long long seed = strtoull(argv[10],NULL,10);
+    std::vector<std::string> params(argv+11,argv+argc);
+    
+    //optional budgets after the algorithm specific parameters, ex. time=10
+    //(see MetaHeuristic_parameters::parseBudget), for every run
+    MetaHeuristic_parameters budgets;
+    while(!params.empty() && budgets.parseBudget(params.back())){
+        params.pop_back();
+    }
+    
+    if((folder!="orlib_data") && (folder!="HiremathHill_data")){
+        std::cout<<"Error, unrecognized folder name."<<std::endl;
+        return 1;
+    }
+    int numberOfParameters = getNumberOfParameters(alg);
+    if(numberOfParameters < 0){
+        std::cout<<"Cannot recognize algorithm, try again."<<std::endl;
+        return 1;
+    }
+    if((params.size() != numberOfParameters) &&
+       !(((alg=="tlbo") || (alg=="aco")) &&
+         (params.size() == numberOfParameters+1))){
+        std::cout<<"Invalid args for "<<alg<<".\n";
+        return 1;
+    }
+    if((mods.size() != 4) && (mods.size() != 5)){
+        std::cout<<"Error, algorithm modifications take 4 or 5 digits."
+            <<std::endl;
+        return 1;
+    }
+    if((format!="csv") && (format!="json")){
+        std::cout<<"Error, unrecognized output format."<<std::endl;
+        return 1;
+    }
+    if(folder=="orlib_data"){
+        problemNumbers.assign(1,1);
+    }
+    
+    /* READ INPUT */
+    std::vector<BatchProblem> problems;
+    for(std::size_t f=0;f<files.size();f++){
+        for(std::size_t p=0;p<problemNumbers.size();p++){
+            BatchProblem problem;
+            problem.file = files[f];
+            problem.problem = problemNumbers[p];
+            problem.dataSet = readProblem(folder,files[f],problemNumbers[p]);
+            if(problem.dataSet.size()==0){
+                std::cerr<<std::string("File ")+files[f]+std::string(" problem ")
+                    <<problemNumbers[p]<<" failed to read."<<std::endl;
+                continue;
+            }
+            //optional fifth modification, 1 = run on the reduced problem,
+            //profits are the same as for the original one
+            if((mods.size() > 4) && ((mods[4] - '0') == 1)){
+                MMKPReduction reduction(problem.dataSet);
+                std::cerr<<files[f]<<" problem "<<problemNumbers[p]<<": "
+                    <<reduction.getStats()<<std::endl;
+                problem.dataSet = reduction.getReducedDataSet();
+            }
+            problems.push_back(problem);
+        }
+    }
+    
+    /* BUILD GRID */
+    //seeds are drawn in grid order, so a seed repeats the whole batch
+    //for any number of threads
+    MMKPRandom rng((seed != 0) ? seed : MMKPRandom::randomSeed());
+    std::vector<BatchRun> runs;
+    for(std::size_t p=0;p<problems.size();p++){
+        for(std::size_t i=0;i<popSizes.size();i++){
+            for(std::size_t j=0;j<genSizes.size();j++){
+                BatchRun run;
+                run.problem = p;
+                run.populationSize = popSizes[i];
+                run.numberOfGenerations = genSizes[j];
+                run.seed = rng();
+                runs.push_back(run);
+            }
+        }
+    }
+    
+    if(format=="csv"){
+        std::cout<<"folder,file,problem,alg,mods,popSize,genSize,seed,"
+            <<"startingProfit,profit,runtime,convergenceGeneration,funcEvals,"
+            <<"convergenceData"<<std::endl;
+    }
+    
+    /* RUN */
+    std::mutex outputMutex;
+    int failures = 0;
+    ThreadPool pool(numberOfThreads);
+    pool.parallelFor(runs.size(),[&](int r){
+        const BatchRun& run = runs[r];
+        const BatchProblem& problem = problems[run.problem];
+        const MMKPDataSet& dataSet = problem.dataSet;
+        
+        //the population, the algorithm and the local search each draw from
+        //their own stream of the run's seed
+        MMKPRandom streams(run.seed);
+        const unsigned int populationSeed = streams();
+        std::unique_ptr<MMKP_MetaHeuristic> algorithm
+            (createAlgorithm(alg,dataSet,mods,run,params,budgets));
+        algorithm->setRandom(streams.split());
+        MMKPRandom localSearchRng = streams.split();
+        
+        //population generation
+        std::unique_ptr<PopulationGenerator> populationGenerator;
+        switch(mods[0] - '0'){
+            case 0: populationGenerator.reset
+                (new GenerateRandomizedPopulation(populationSeed)); break;
+            case 1: populationGenerator.reset
+                (new GenerateRandomizedPopulationNoDups(populationSeed)); break;
+            case 2: populationGenerator.reset
+                (new GenerateRandomizedPopulationNoDups_Infeasible(populationSeed));
+                break;
+            case 3: populationGenerator.reset
+                (new GenerateRandomizedPopulationGreedyV1(populationSeed)); break;
+            default: populationGenerator.reset
+                (new GenerateRandomizedPopulationConstructive(populationSeed));
+                break;
+        }
+        std::vector<MMKPSolution> initPopulation =
+            (*populationGenerator)(dataSet,run.populationSize);
+        
+        algorithm->sortPopulation(initPopulation);
+        MMKPSolution initialBest;
+        initialBest.setProfit(-1);
+        for(int i=0;i<initPopulation.size();i++){
+            if(dataSet.isFeasible(initPopulation[i])){
+                initialBest = initPopulation[i];
+                break;
+            }
+        }
+        
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        MMKPSolution optimalSolution;
+        try{
+            optimalSolution = (*algorithm)(initPopulation);
+            
+            //local search heuristics
+            if((mods[3] - '0') == 1){
+                CompLocalSearch CLS(dataSet);
+                optimalSolution = CLS(optimalSolution);
+            }
+            if((mods[3] - '0') == 2){
+                ReactiveLocalSearch RLS(dataSet,localSearchRng);
+                optimalSolution = RLS(optimalSolution);
+            }
+        }catch(std::exception& e){
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cerr<<problem.file<<" problem "<<problem.problem<<": "
+                <<e.what()<<std::endl;
+            failures++;
+            return;
+        }
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        double runtime = std::chrono::duration<double>(t2-t1).count();
+        
+        std::vector<std::tuple<int,float> > convData =
+            algorithm->getConvergenceData();
+        float profit = dataSet.isFeasible(optimalSolution) ?
+            optimalSolution.getProfit() : 0;
+        int funcEvals = convData.empty() ? 0 : std::get<0>(convData.back());
+        
+        //build the line first, so runs never interleave
+        std::ostringstream line;
+        if(format=="csv"){
+            line<<folder<<","<<problem.file<<","<<problem.problem<<","<<alg
+                <<","<<mods<<","<<run.populationSize<<","
+                <<run.numberOfGenerations<<","<<run.seed<<","
+                <<initialBest.getProfit()<<","<<profit<<","<<runtime<<","
+                <<algorithm->getConvergenceGeneration()<<","<<funcEvals<<",";
+            for(std::size_t i=0;i<convData.size();i++){
+                line<<((i==0) ? "" : " ")<<std::get<0>(convData[i])<<":"
+                    <<std::get<1>(convData[i]);
+            }
+        }else{
+            line<<"{\"folder\":\""<<folder<<"\",\"file\":\""<<problem.file
+                <<"\",\"problem\":"<<problem.problem<<",\"alg\":\""<<alg
+                <<"\",\"mods\":\""<<mods<<"\",\"popSize\":"
+                <<run.populationSize<<",\"genSize\":"<<run.numberOfGenerations
+                <<",\"seed\":"<<run.seed<<",\"startingProfit\":"
+                <<initialBest.getProfit()<<",\"profit\":"<<profit
+                <<",\"runtime\":"<<runtime<<",\"convergenceGeneration\":"
+                <<algorithm->getConvergenceGeneration()<<",\"funcEvals\":"
+                <<funcEvals<<",\"convergenceData\":[";
+            for(std::size_t i=0;i<convData.size();i++){
+                line<<((i==0) ? "" : ",")<<"["<<std::get<0>(convData[i])<<","
+                    <<std::get<1>(convData[i])<<"]";
+            }
+            line<<"]}";
+        }
+        
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout<<line.str()<<std::endl;
+    });
+    
+    return (failures==0) ? 0 : 1;
+}
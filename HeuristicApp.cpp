@@ -9,6 +9,8 @@
  * Main driver for running/testing MMKP problem instances. Takes command
  * line arguments folder, file, problem number, algorithm (ex. tlbo), 
  * algorithm mods (ex. 0010), population size, and number of generations.
+ * Budgets, ex. time=10 evals=50000 target=3900 stagnation=20, may follow
+ * the algorithm specific parameters.
  *
  * The MIT License (MIT)
  *
@@ -37,9 +39,12 @@
 #include <iostream>
 #include <stdlib.h> //atoi
 #include <time.h>
+#include <chrono>
 #include <string>
 
 #include "MMKPDataSet.h"
+#include "MMKPBinary.h"
+#include "MMKPReduction.h"
 #include "MMKPSolution.h"
 #include "MMKPPopulationGenerators.h"
 #include "MMKP_ABC.h"
@@ -50,6 +55,7 @@
 #include "MMKP_TLBO.h"
 #include "MMKP_LocalSearch.h"
 #include "MMKP_PSO.h"
+#include "MMKP_IslandModel.h"
 
 int main(int argc, char* argv[]){
     
@@ -63,42 +69,72 @@ int main(int argc, char* argv[]){
     int popSize = atoi(argv[6]);
     int genSize = atoi(argv[7]);
     
+    //optional budgets after the other arguments, ex. time=10 (see
+    //MetaHeuristic_parameters::parseBudget)
+    MetaHeuristic_parameters budgets;
+    while((argc > 8) && budgets.parseBudget(argv[argc-1])){
+        argc--;
+    }
+    
     std::ifstream fileStream;
     MMKPDataSet dataSet;
-    clock_t t1,t2;
+    //wall clock time, clock() would add up the time of every thread
+    std::chrono::steady_clock::time_point t1,t2;
     float runtime;
-    fileStream.open(folder+std::string("/")+file);
     
     /* READ INPUT */
-    if(fileStream.is_open()){
-        //build MMKPDataSet object
-        if(folder=="orlib_data"){
-            OrLib_Read readInput;
-            dataSet = readInput(fileStream);
-        }else if(folder=="HiremathHill_data"){
-            HiremathHill_Read readInput;
-            dataSet = readInput(fileStream,problem);
+    //use a converted binary file (see MMKPConvert) when there is one
+    MMKPBinary_Read readBinary;
+    dataSet = readBinary(folder+std::string("/")+file+MMKP_BINARY_EXTENSION,
+                         problem);
+    if(dataSet.size()==0){
+        fileStream.open(folder+std::string("/")+file);
+        if(fileStream.is_open()){
+            //build MMKPDataSet object
+            if(folder=="orlib_data"){
+                OrLib_Read readInput;
+                dataSet = readInput(fileStream);
+            }else if(folder=="HiremathHill_data"){
+                HiremathHill_Read readInput;
+                dataSet = readInput(fileStream,problem,
+                                    folder+std::string("/")+file);
+            }else{
+                std::cout<<"Error, unrecognized folder name."<<std::endl;
+            }
         }else{
-            std::cout<<"Error, unrecognized folder name."<<std::endl;
+            std::cerr<<std::string("File ")+file+std::string(" failed to open.")
+            <<std::endl;
         }
-    }else{
-        std::cerr<<std::string("File ")+file+std::string(" failed to open.")
-        <<std::endl;
+        fileStream.close();
+    }
+    
+    /* REDUCE INPUT */
+    //optional fifth modification, 1 = run on the reduced problem
+    MMKPReduction* reduction = NULL;
+    if((mods.size() > 4) && ((mods[4] - '0') == 1) && (dataSet.size() != 0)){
+        reduction = new MMKPReduction(dataSet);
+        std::cerr<<reduction->getStats()<<std::endl;
+        dataSet = reduction->getReducedDataSet();
     }
-    fileStream.close();
     
     MMKP_MetaHeuristic* algorithm;
     
     if(alg.compare("aco")==0){
-            if(argc != 11){std::cout<<"Invalid args for aco.\n";return 0;}
+            if((argc != 11) && (argc != 12)){
+                std::cout<<"Invalid args for aco.\n";return 0;
+            }
             ACO_parameters parameters;
             parameters.B = atof(argv[8]);
             parameters.p = atof(argv[9]);
             parameters.e = atof(argv[10]);
+            if(argc == 12){
+                parameters.numberOfThreads = atoi(argv[11]);
+            }
             parameters.numberOfGenerations = genSize;
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             algorithm = new MMKP_ACO(dataSet,parameters);
     }else if(alg.compare("coa")==0){
             if(argc != 10){std::cout<<"Invalid args for coa.\n";return 0;}
@@ -109,6 +145,7 @@ int main(int argc, char* argv[]){
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             algorithm = new MMKP_COA(dataSet,parameters);
     }else if(alg.compare("bba")==0){
             if(argc != 8){std::cout<<"Invalid args for coa.\n";return 0;}
@@ -117,6 +154,7 @@ int main(int argc, char* argv[]){
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             algorithm = new MMKP_BBA(dataSet,parameters);
     }else if(alg.compare("ga")==0){
             if(argc != 10){std::cout<<"Invalid args for ga.\n";return 0;}
@@ -127,6 +165,7 @@ int main(int argc, char* argv[]){
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             algorithm = new MMKP_GA(dataSet,parameters);
     }else if(alg.compare("abc")==0){
             if(argc != 8){std::cout<<"Invalid args for abc.\n";return 0;}
@@ -135,6 +174,7 @@ int main(int argc, char* argv[]){
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             algorithm = new MMKP_ABC(dataSet,parameters);
     }else if(alg.compare("pso")==0){
             if(argc != 9){std::cout<<"Invalid args for pso.\n";return 0;}
@@ -143,18 +183,69 @@ int main(int argc, char* argv[]){
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             parameters.learningFactor = atof(argv[8]);
             algorithm = new MMKP_PSO(dataSet,parameters);
     }else if(alg.compare("tlbo")==0){
-            if(argc != 10){std::cout<<"Invalid args for tlbo.\n";return 0;}
+            if((argc != 10) && (argc != 11)){
+                std::cout<<"Invalid args for tlbo.\n";return 0;
+            }
             TLBO_parameters parameters;
             parameters.numberOfGenerations = genSize;
             parameters.populationSize = popSize;
             parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
             parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
             parameters.alg_Type = atof(argv[8]);
             parameters.rls_on = atof(argv[9]);
+            if(argc == 11){
+                parameters.numberOfThreads = atoi(argv[10]);
+            }
             algorithm = new MMKP_TLBO(dataSet,parameters);
+    }else if(alg.compare("island")==0){
+            if(argc != 12){std::cout<<"Invalid args for island.\n";return 0;}
+            IslandModel_parameters parameters;
+            parameters.topology = atoi(argv[8]);
+            parameters.migrationInterval = atoi(argv[9]);
+            parameters.numberOfMigrants = atoi(argv[10]);
+            parameters.numberOfGenerations = genSize;
+            parameters.populationSize = popSize;
+            parameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+            parameters.multipleDimFeasibilityMod = mods[2] - '0';
+            parameters.setBudgets(budgets);
+            parameters.seed = seed;
+            MMKP_IslandModel* islandModel = new MMKP_IslandModel(dataSet,parameters);
+            
+            //islands take turns running tlbo, coa and ga (as MmhphApp), run
+            //seeds each from its own split of the model's seed
+            int numberOfIslands = atoi(argv[11]);
+            for(int i=0;i<numberOfIslands;i++){
+                int islandSize = popSize/numberOfIslands +
+                    ((i < popSize%numberOfIslands) ? 1 : 0);
+                if(i%3 == 0){
+                    TLBO_parameters islandParameters;
+                    islandParameters.populationSize = islandSize;
+                    islandParameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+                    islandParameters.multipleDimFeasibilityMod = mods[2] - '0';
+                    islandModel->addIsland(std::shared_ptr<MMKP_MetaHeuristic>
+                                        (new MMKP_TLBO(dataSet,islandParameters)));
+                }else if(i%3 == 1){
+                    COA_parameters islandParameters;
+                    islandParameters.populationSize = islandSize;
+                    islandParameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+                    islandParameters.multipleDimFeasibilityMod = mods[2] - '0';
+                    islandModel->addIsland(std::shared_ptr<MMKP_MetaHeuristic>
+                                        (new MMKP_COA(dataSet,islandParameters)));
+                }else{
+                    GA_parameters islandParameters;
+                    islandParameters.populationSize = islandSize;
+                    islandParameters.multipleChoiceFeasibilityMod = mods[1] - '0';
+                    islandParameters.multipleDimFeasibilityMod = mods[2] - '0';
+                    islandModel->addIsland(std::shared_ptr<MMKP_MetaHeuristic>
+                                        (new MMKP_GA(dataSet,islandParameters)));
+                }
+            }
+            algorithm = islandModel;
     }else{
             std::cout<<"Cannot recognize algorithm, try again."<<std::endl;
             return 0;
@@ -162,17 +253,18 @@ int main(int argc, char* argv[]){
     }
     
     /* POPULATION GENERATION */
-    PopulationGenerator* populationGenerator[4];
+    PopulationGenerator* populationGenerator[5];
     populationGenerator[0] = new GenerateRandomizedPopulation(seed);
     populationGenerator[1] = new GenerateRandomizedPopulationNoDups(seed);
     populationGenerator[2] = new GenerateRandomizedPopulationNoDups_Infeasible(seed);
     populationGenerator[3] = new GenerateRandomizedPopulationGreedyV1(seed);
+    populationGenerator[4] = new GenerateRandomizedPopulationConstructive(seed);
     
     int populationGenIndx = mods[0] - '0';
     std::vector<MMKPSolution> initPopulation
         = (*(populationGenerator[populationGenIndx]))(dataSet,popSize);
     
-    algorithm->quickSort(initPopulation,0,(initPopulation.size()-1));
+    algorithm->sortPopulation(initPopulation);
     MMKPSolution initialBest;
     initialBest.setProfit(-1);
     for(int i=0;i<initPopulation.size();i++){
@@ -187,8 +279,9 @@ int main(int argc, char* argv[]){
     delete populationGenerator[1];
     delete populationGenerator[2];
     delete populationGenerator[3];
+    delete populationGenerator[4];
     
-    t1=clock();
+    t1 = std::chrono::steady_clock::now();
     MMKPSolution optimalSolution = (*algorithm)(initPopulation);
     
     //local search heuristics
@@ -201,10 +294,16 @@ int main(int argc, char* argv[]){
         optimalSolution = RLS(optimalSolution);
     }
     
-    t2 = clock();
-    runtime = ((float)t2-(float)t1)/(double) CLOCKS_PER_SEC;
+    t2 = std::chrono::steady_clock::now();
+    runtime = std::chrono::duration<double>(t2-t1).count();
     std::vector<std::tuple<int,float> > convData = algorithm->getConvergenceData();
     
+    //report the items of the original problem
+    if(reduction != NULL){
+        optimalSolution = reduction->expand(optimalSolution);
+        dataSet = reduction->getOriginalDataSet();
+    }
+    
     std::cout<<"Problem: "<<std::endl;
     std::cout<<folder<<std::string("/")<<file<<std::endl;
     std::cout<<"Problem Number:"<<std::endl;
@@ -238,6 +337,7 @@ int main(int argc, char* argv[]){
     std::cout<<std::endl;
     
     delete algorithm;
+    delete reduction;
     
     return 0;
 }
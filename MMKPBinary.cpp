@@ -0,0 +1,233 @@
+/*********************************************************
+ *
+ * File: MMKPBinary.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPBinary
+ *
+ *********************************************************/
+
+#include "MMKPBinary.h"
+
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char MMKP_BINARY_MAGIC[8] = {'M','M','K','P','B','I','N','\0'};
+
+/**
+ * Round bytes up to the next FLAT_DATA_ALIGNMENT boundary.
+ */
+static uint64_t alignUp(uint64_t bytes){
+    return ((bytes + FLAT_DATA_ALIGNMENT - 1)/FLAT_DATA_ALIGNMENT)
+            * FLAT_DATA_ALIGNMENT;
+}
+
+/**
+ * Byte offsets of each section of a problem, relative to entry.offset.
+ */
+typedef struct{
+    uint64_t classOffsets;
+    uint64_t resources;
+    uint64_t profits;
+    uint64_t costs;
+    uint64_t end;
+}MMKPBinaryLayout;
+
+static MMKPBinaryLayout getLayout(const MMKPBinaryProblemEntry& entry){
+    MMKPBinaryLayout layout;
+    layout.classOffsets = 0;
+    layout.resources = alignUp(sizeof(int32_t)*(entry.numberOfClasses+1));
+    layout.profits = layout.resources + alignUp(sizeof(float)*entry.stride);
+    layout.costs = layout.profits + alignUp(sizeof(float)*entry.numberOfItems);
+    layout.end = layout.costs + alignUp(sizeof(float)*
+                                        (uint64_t)entry.numberOfItems*entry.stride);
+    return layout;
+}
+
+/* MMKPMappedFile */
+
+MMKPMappedFile::MMKPMappedFile(const std::string& fileName):data(NULL),length(0){
+    int fd = open(fileName.c_str(),O_RDONLY);
+    if(fd < 0){return;}
+    struct stat fileStat;
+    if((fstat(fd,&fileStat) == 0) && (fileStat.st_size > 0)){
+        void* p = mmap(NULL,fileStat.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if(p != MAP_FAILED){
+            this->data = static_cast<const char*>(p);
+            this->length = fileStat.st_size;
+        }
+    }
+    close(fd);
+}
+
+MMKPMappedFile::~MMKPMappedFile(){
+    if(this->data != NULL){
+        munmap(const_cast<char*>(this->data),this->length);
+    }
+}
+
+bool MMKPMappedFile::isOpen() const{
+    return (this->data != NULL);
+}
+
+const char* MMKPMappedFile::getData() const{
+    return this->data;
+}
+
+std::size_t MMKPMappedFile::size() const{
+    return this->length;
+}
+
+/* MMKPBinary_Read */
+
+MMKPDataSet MMKPBinary_Read::operator()(const std::string& fileName,
+                                        int problemToRun){
+    std::shared_ptr<MMKPMappedFile> file(new MMKPMappedFile(fileName));
+    if(!file->isOpen()){
+        return MMKPDataSet();
+    }
+
+    //check header
+    const char* data = file->getData();
+    MMKPBinaryHeader header;
+    if(file->size() < sizeof(header)){
+        std::cerr<<fileName<<" is not a binary MMKP file."<<std::endl;
+        return MMKPDataSet();
+    }
+    std::memcpy(&header,data,sizeof(header));
+    if(std::memcmp(header.magic,MMKP_BINARY_MAGIC,sizeof(header.magic)) != 0){
+        std::cerr<<fileName<<" is not a binary MMKP file."<<std::endl;
+        return MMKPDataSet();
+    }
+    if((header.version != MMKP_BINARY_VERSION) ||
+       (header.byteOrder != MMKP_BINARY_BYTE_ORDER) ||
+       (header.alignment != FLAT_DATA_ALIGNMENT)){
+        std::cerr<<fileName<<" was written by an incompatible version or "
+            <<"machine, convert it again (MMKPConvert)."<<std::endl;
+        return MMKPDataSet();
+    }
+    uint64_t directoryEnd = sizeof(header) +
+        (uint64_t)header.numberOfProblems*sizeof(MMKPBinaryProblemEntry);
+    if(file->size() < directoryEnd){
+        std::cerr<<fileName<<" is truncated."<<std::endl;
+        return MMKPDataSet();
+    }
+
+    //find problem
+    for(uint32_t i=0;i<header.numberOfProblems;i++){
+        MMKPBinaryProblemEntry entry;
+        std::memcpy(&entry,data+sizeof(header)+i*sizeof(entry),sizeof(entry));
+        if(entry.problemNumber != problemToRun){continue;}
+
+        MMKPBinaryLayout layout = getLayout(entry);
+        if((entry.offset%FLAT_DATA_ALIGNMENT != 0) ||
+           (entry.stride%FLAT_DATA_STRIDE_MULTIPLE != 0) ||
+           (entry.stride < entry.numberOfResources) ||
+           (file->size() < entry.offset+layout.end)){
+            std::cerr<<fileName<<" is corrupt."<<std::endl;
+            return MMKPDataSet();
+        }
+        const char* problem = data + entry.offset;
+        const int32_t* offsets =
+            reinterpret_cast<const int32_t*>(problem+layout.classOffsets);
+        std::vector<int> classOffsets(offsets,offsets+entry.numberOfClasses+1);
+        if(classOffsets.back() != entry.numberOfItems){
+            std::cerr<<fileName<<" is corrupt."<<std::endl;
+            return MMKPDataSet();
+        }
+        MMKPFlatData flatData(classOffsets,entry.numberOfResources,entry.stride,
+                reinterpret_cast<const float*>(problem+layout.resources),
+                reinterpret_cast<const float*>(problem+layout.profits),
+                reinterpret_cast<const float*>(problem+layout.costs),file);
+        return MMKPDataSet(flatData);
+    }
+    return MMKPDataSet();
+}
+
+/* MMKPBinary_Write */
+
+/**
+ * Write count bytes of src, followed by zeros up to paddedCount bytes.
+ */
+static void writePadded(std::ofstream& file, const void* src,
+                        uint64_t count, uint64_t paddedCount){
+    static const char zeros[FLAT_DATA_ALIGNMENT] = {0};
+    file.write(static_cast<const char*>(src),count);
+    while(count < paddedCount){
+        uint64_t n = std::min<uint64_t>(paddedCount-count,FLAT_DATA_ALIGNMENT);
+        file.write(zeros,n);
+        count += n;
+    }
+}
+
+bool MMKPBinary_Write::operator()(const std::string& fileName,
+                                  const std::vector<MMKPDataSet>& dataSets,
+                                  const std::vector<int>& problemNumbers){
+    assert(dataSets.size() == problemNumbers.size());
+
+    MMKPBinaryHeader header;
+    std::memcpy(header.magic,MMKP_BINARY_MAGIC,sizeof(header.magic));
+    header.version = MMKP_BINARY_VERSION;
+    header.byteOrder = MMKP_BINARY_BYTE_ORDER;
+    header.alignment = FLAT_DATA_ALIGNMENT;
+    header.numberOfProblems = dataSets.size();
+
+    //build directory
+    std::vector<MMKPBinaryProblemEntry> entries(dataSets.size());
+    uint64_t offset = alignUp(sizeof(header) +
+                              entries.size()*sizeof(MMKPBinaryProblemEntry));
+    for(std::size_t i=0;i<dataSets.size();i++){
+        const MMKPFlatData& flatData = dataSets[i].getFlatData();
+        entries[i].problemNumber = problemNumbers[i];
+        entries[i].numberOfClasses = flatData.getNumberOfClasses();
+        entries[i].numberOfItems = flatData.getNumberOfItems();
+        entries[i].numberOfResources = flatData.getNumberOfResources();
+        entries[i].stride = flatData.getStride();
+        entries[i].reserved = 0;
+        entries[i].offset = offset;
+        offset += getLayout(entries[i]).end;
+    }
+
+    std::ofstream file(fileName.c_str(),std::ios::out|std::ios::binary|
+                       std::ios::trunc);
+    if(!file.is_open()){
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header),sizeof(header));
+    uint64_t directorySize = entries.size()*sizeof(MMKPBinaryProblemEntry);
+    writePadded(file,entries.data(),directorySize,
+                alignUp(sizeof(header)+directorySize)-sizeof(header));
+
+    //write each problem
+    for(std::size_t i=0;i<dataSets.size();i++){
+        const MMKPFlatData& flatData = dataSets[i].getFlatData();
+        const MMKPBinaryProblemEntry& entry = entries[i];
+        MMKPBinaryLayout layout = getLayout(entry);
+
+        std::vector<int32_t> classOffsets(entry.numberOfClasses+1);
+        for(uint32_t c=0;c<=entry.numberOfClasses;c++){
+            classOffsets[c] = flatData.getClassOffset(c);
+        }
+        writePadded(file,classOffsets.data(),
+                    sizeof(int32_t)*classOffsets.size(),
+                    layout.resources-layout.classOffsets);
+        writePadded(file,flatData.getResources(),sizeof(float)*entry.stride,
+                    layout.profits-layout.resources);
+        writePadded(file,flatData.getProfits(),
+                    sizeof(float)*entry.numberOfItems,
+                    layout.costs-layout.profits);
+        uint64_t costsSize = sizeof(float)*(uint64_t)entry.numberOfItems*
+                             entry.stride;
+        writePadded(file,(entry.numberOfItems>0) ? flatData.getCosts(0) : NULL,
+                    costsSize,layout.end-layout.costs);
+    }
+    file.close();
+    return !file.fail();
+}
@@ -0,0 +1,170 @@
+/*********************************************************
+ *
+ * File: MMKPBinary.h
+ * Author: Ken Zyma
+ *
+ * Memory mappable binary MMKP instance format.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPBinary__
+#define ____MMKPBinary__
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+#include "MMKPDataSet.h"
+#include "MMKPFlatData.h"
+
+/**
+ * Binary MMKP instance format. A file holds one or more problems (all the
+ * problems of a Hiremath/Hill text file, or the single Or-Lib problem) and
+ * is laid out so that it can be memory mapped and used directly as the
+ * storage of MMKPFlatData:
+ *
+ *   MMKPBinaryHeader
+ *   MMKPBinaryProblemEntry[numberOfProblems]
+ *   for each problem, starting at entry.offset:
+ *       int32 classOffsets[numberOfClasses+1]
+ *       float resources[stride]
+ *       float profits[numberOfItems]
+ *       float costs[numberOfItems*stride]
+ *
+ * Every section starts on a FLAT_DATA_ALIGNMENT boundary and is zero
+ * padded, cost rows are padded to stride floats as in MMKPFlatData. Values
+ * are stored in native byte order, a file written on a machine of
+ * different endianness is rejected by the reader.
+ */
+
+/**
+ * Extension given to converted files, ex. orlib_data/I01.mmkp.
+ */
+const std::string MMKP_BINARY_EXTENSION = ".mmkp";
+
+/**
+ * Version written into (and expected from) MMKPBinaryHeader, bump
+ * whenever the layout changes.
+ */
+const uint32_t MMKP_BINARY_VERSION = 1;
+
+/**
+ * Used to detect files written in a different byte order.
+ */
+const uint32_t MMKP_BINARY_BYTE_ORDER = 0x01020304;
+
+typedef struct{
+    char magic[8];              //"MMKPBIN"
+    uint32_t version;
+    uint32_t byteOrder;         //MMKP_BINARY_BYTE_ORDER
+    uint32_t alignment;         //FLAT_DATA_ALIGNMENT at write time
+    uint32_t numberOfProblems;
+}MMKPBinaryHeader;
+
+typedef struct{
+    uint32_t problemNumber;     //problem number as in the text file
+    uint32_t numberOfClasses;
+    uint32_t numberOfItems;
+    uint32_t numberOfResources;
+    uint32_t stride;
+    uint32_t reserved;
+    uint64_t offset;            //byte offset of the problem from file start
+}MMKPBinaryProblemEntry;
+
+/**
+ * Read only memory mapping of a file. The mapping is released when the
+ * object is destroyed, share it (std::shared_ptr) to keep borrowed data
+ * alive.
+ */
+class MMKPMappedFile{
+    
+private:
+    const char* data;
+    std::size_t length;
+    
+    MMKPMappedFile(const MMKPMappedFile&);
+    MMKPMappedFile& operator=(const MMKPMappedFile&);
+public:
+    /**
+     * Map file fileName, check isOpen for success.
+     */
+    explicit MMKPMappedFile(const std::string& fileName);
+    
+    ~MMKPMappedFile();
+    
+    /**
+     * Return true if the file was mapped.
+     */
+    bool isOpen() const;
+    
+    /**
+     * Return pointer to the first byte of the mapping.
+     */
+    const char* getData() const;
+    
+    /**
+     * Return length of the mapping in bytes.
+     */
+    std::size_t size() const;
+};
+
+/**
+ * MMKPBinary_Read Function Object maps a binary MMKP file and converts
+ * one of its problems to common format MMKPDataSet. Profits, costs and
+ * resources of the data set's flat data are read directly from the
+ * mapping.
+ */
+class MMKPBinary_Read{
+    
+public:
+    /**
+     * Return problem problemToRun (starting at index 1, Or-Lib files hold
+     * only problem 1) of binary file fileName. An empty MMKPDataSet
+     * (size() == 0) is returned if the file does not exist, is not a
+     * compatible binary file (reported on std::cerr), or does not hold
+     * the problem.
+     */
+    MMKPDataSet operator()(const std::string& fileName, int problemToRun);
+};
+
+/**
+ * MMKPBinary_Write Function Object writes MMKPDataSets to a binary MMKP
+ * file. See MMKPConvert for converting the text problem sets.
+ */
+class MMKPBinary_Write{
+    
+public:
+    /**
+     * Write dataSets to file fileName, dataSets[i] is stored as problem
+     * problemNumbers[i]. Return true on success.
+     */
+    bool operator()(const std::string& fileName,
+                    const std::vector<MMKPDataSet>& dataSets,
+                    const std::vector<int>& problemNumbers);
+};
+
+#endif /* defined(____MMKPBinary__) */
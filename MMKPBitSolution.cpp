@@ -0,0 +1,145 @@
+/*********************************************************
+ *
+ * File: MMKPBitSolution.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPBitSolution
+ *
+ *********************************************************/
+
+#include "MMKPBitSolution.h"
+
+/* MMKPBitSolution */
+
+MMKPBitSolution::MMKPBitSolution():numberOfItems(0){}
+
+MMKPBitSolution::MMKPBitSolution(int numberOfItems)
+:words((numberOfItems+63)/64,0),numberOfItems(numberOfItems){}
+
+MMKPBitSolution::MMKPBitSolution(const MMKPSolution& solution):numberOfItems(0){
+    MMKPBitSolution::fromSolution(solution);
+}
+
+//accessors
+int MMKPBitSolution::size() const{
+    return this->numberOfItems;
+}
+
+int MMKPBitSolution::getNumberOfWords() const{
+    return this->words.size();
+}
+
+uint64_t MMKPBitSolution::getWordMask(int w) const{
+    const int bits = this->numberOfItems - w*64;
+    return (bits >= 64) ? ~(uint64_t)0 : (((uint64_t)1<<bits)-1);
+}
+
+int MMKPBitSolution::count() const{
+    int count = 0;
+    for(std::size_t w=0;w<this->words.size();w++){
+        count += __builtin_popcountll(this->words[w]);
+    }
+    return count;
+}
+
+void MMKPBitSolution::toSolution(MMKPSolution& solution) const{
+    int item = 0;
+    for(int i=0;i<solution.size();i++){
+        std::vector<bool>& bits = solution[i];
+        const int classSize = bits.size();
+        for(int j=0;j<classSize;){
+            //copy up to the end of the class or of the word
+            const int count = std::min(classSize-j,64-(item%64));
+            unpackBits(this->words[item/64]>>(item%64),bits,j,count);
+            j += count;
+            item += count;
+        }
+    }
+    assert(item == this->numberOfItems);
+}
+
+//mutators
+void MMKPBitSolution::fromSolution(const MMKPSolution& solution){
+    int numberOfItems = 0;
+    for(int i=0;i<solution.size();i++){
+        numberOfItems += solution[i].size();
+    }
+    this->numberOfItems = numberOfItems;
+    this->words.assign((numberOfItems+63)/64,0);
+    
+    int item = 0;
+    for(int i=0;i<solution.size();i++){
+        const std::vector<bool>& bits = solution[i];
+        const int classSize = bits.size();
+        for(int j=0;j<classSize;){
+            const int count = std::min(classSize-j,64-(item%64));
+            this->words[item/64] |= packBits(bits,j,count)<<(item%64);
+            j += count;
+            item += count;
+        }
+    }
+}
+
+//static helpers
+uint64_t MMKPBitSolution::packBits(const std::vector<bool>& bits, int from,
+                                   int count){
+    assert((count <= 64) && (from+count <= bits.size()));
+    uint64_t word = 0;
+    std::vector<bool>::const_iterator it = bits.begin()+from;
+    for(int k=0;k<count;k++,++it){
+        word |= (uint64_t)(*it)<<k;
+    }
+    return word;
+}
+
+void MMKPBitSolution::unpackBits(uint64_t word, std::vector<bool>& bits,
+                                 int from, int count){
+    assert((count <= 64) && (from+count <= bits.size()));
+    std::vector<bool>::iterator it = bits.begin()+from;
+    for(int k=0;k<count;k++,++it){
+        *it = (word>>k) & 1;
+    }
+}
+
+/* bit kernels */
+
+uint32_t getBernoulliThreshold(float p){
+    if(!(p > 0)){return 0;}
+    if(p >= 1){return (uint32_t)1<<24;}
+    return (uint32_t)(p*16777216.0f);
+}
+
+uint64_t nextBernoulliBits(MMKPRandom& rng, const uint32_t* thresholds,
+                           const uint64_t* selectors, int numberOfSelectors){
+    uint64_t mask = 0;
+    uint64_t isOne = 0;     //threshold 2^24, always set
+    for(int s=0;s<numberOfSelectors;s++){
+        mask |= selectors[s];
+        if(thresholds[s] >= ((uint32_t)1<<24)){
+            isOne |= selectors[s];
+        }
+    }
+    
+    //bit sliced u < threshold, most significant bit first. less holds the
+    //bits already known to be below, equal those still undecided
+    uint64_t less = 0;
+    uint64_t equal = mask & ~isOne;
+    for(int b=23;(b>=0) && (equal!=0);b--){
+        uint64_t u = rng();
+        uint64_t t = 0;
+        for(int s=0;s<numberOfSelectors;s++){
+            t |= selectors[s] & (0-(uint64_t)((thresholds[s]>>b) & 1));
+        }
+        less |= equal & ~u & t;
+        equal &= ~(u ^ t);
+    }
+    return (less | isOne) & mask;
+}
+
+uint64_t nextBernoulliBits(MMKPRandom& rng, float p, uint64_t mask){
+    uint32_t threshold = getBernoulliThreshold(p);
+    return nextBernoulliBits(rng,&threshold,&mask,1);
+}
@@ -0,0 +1,153 @@
+/*********************************************************
+ *
+ * File: MMKPBitSolution.h
+ * Author: Ken Zyma
+ *
+ * Bit-packed MMKP solution and word-parallel bit kernels.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPBitSolution__
+#define ____MMKPBitSolution__
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <stdint.h>
+#include <assert.h>
+
+#include "MMKPSolution.h"
+#include "MMKPRandom.h"
+
+/**
+ * Bit-packed copy of the item selection of an MMKPSolution. Items are
+ * numbered class after class (the flat index of MMKPFlatData), item i is
+ * bit i%64 of word i/64. Bits past the last item are always 0.
+ *
+ * Bitwise operators run a word (64 items) at a time on it, drawing whole
+ * words of random bits (see nextBernoulliBits), and the result is written
+ * back to an MMKPSolution with toSolution.
+ */
+class MMKPBitSolution{
+
+private:
+    std::vector<uint64_t> words;
+    int numberOfItems;
+public:
+    /**
+     * Construct empty MMKPBitSolution.
+     */
+    MMKPBitSolution();
+    
+    /**
+     * Construct MMKPBitSolution of numberOfItems items, none selected.
+     */
+    explicit MMKPBitSolution(int numberOfItems);
+    
+    /**
+     * Construct MMKPBitSolution holding the items selected in solution.
+     */
+    explicit MMKPBitSolution(const MMKPSolution& solution);
+    
+    //accessors
+    /**
+     * Return number of items.
+     */
+    int size() const;
+    
+    /**
+     * Return number of words.
+     */
+    int getNumberOfWords() const;
+    
+    /**
+     * Return word w.
+     */
+    uint64_t getWord(int w) const{return words[w];}
+    
+    /**
+     * Return the mask of the bits of word w that hold items.
+     */
+    uint64_t getWordMask(int w) const;
+    
+    /**
+     * Return number of items selected.
+     */
+    int count() const;
+    
+    /**
+     * Write the selection into param: solution, which must have the same
+     * classes. Profit and costs are not updated.
+     */
+    void toSolution(MMKPSolution& solution) const;
+    
+    //mutators
+    /**
+     * Set word w, bits past the last item are cleared.
+     */
+    void setWord(int w, uint64_t word){words[w] = word & getWordMask(w);}
+    
+    /**
+     * Set the selection from param: solution.
+     */
+    void fromSolution(const MMKPSolution& solution);
+    
+    //static helpers
+    /**
+     * Return bits from, from+1, ... from+count-1 (count <= 64) of param:
+     * bits as the low bits of a word.
+     */
+    static uint64_t packBits(const std::vector<bool>& bits, int from, int count);
+    
+    /**
+     * Set bits from ... from+count-1 of param: bits to the low count bits
+     * of param: word.
+     */
+    static void unpackBits(uint64_t word, std::vector<bool>& bits, int from,
+                           int count);
+};
+
+/**
+ * Return p (0 to 1) as a threshold for nextBernoulliBits, p*2^24.
+ */
+uint32_t getBernoulliThreshold(float p);
+
+/**
+ * Return a word of independent random bits, bit i is set with probability
+ * thresholds[s]/2^24 for the s with bit i set in selectors[s]. Selectors
+ * must not overlap, bits in none of them are 0. Each bit compares a 24 bit
+ * uniform number, built from bit i of successive words of rng, with its
+ * threshold from the most significant bit down, and stops once every bit
+ * is decided, on average after a handful of words.
+ */
+uint64_t nextBernoulliBits(MMKPRandom& rng, const uint32_t* thresholds,
+                           const uint64_t* selectors, int numberOfSelectors);
+
+/**
+ * Return a word with the bits of mask each set with probability p.
+ */
+uint64_t nextBernoulliBits(MMKPRandom& rng, float p, uint64_t mask);
+
+#endif /* defined(____MMKPBitSolution__) */
@@ -0,0 +1,141 @@
+/*********************************************************
+ *
+ * File: MMKPChoiceSolution.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPChoiceSolution
+ *
+ *********************************************************/
+
+#include "MMKPChoiceSolution.h"
+
+/* MMKPChoiceSolution */
+
+const short MMKPChoiceSolution::NO_CHOICE;
+
+MMKPChoiceSolution::MMKPChoiceSolution():profitSummation(0){}
+
+MMKPChoiceSolution::MMKPChoiceSolution(int numberOfClasses,
+                                       int numberOfConstraints)
+:choices(numberOfClasses,NO_CHOICE),profitSummation(0),
+costsSummation(numberOfConstraints,0){}
+
+MMKPChoiceSolution::MMKPChoiceSolution(MMKPSolution& solution)
+:profitSummation(0){
+    MMKPChoiceSolution::fromSolution(solution);
+}
+
+//operator overloading
+short MMKPChoiceSolution::operator[](int index) const{
+    assert(index<this->choices.size());
+    return this->choices[index];
+}
+
+bool MMKPChoiceSolution::operator==(const MMKPChoiceSolution& other) const{
+    return (this->choices == other.choices);
+}
+
+bool MMKPChoiceSolution::operator!=(const MMKPChoiceSolution& other) const{
+    return !(*this == other);
+}
+
+//accessors
+int MMKPChoiceSolution::size() const{
+    return this->choices.size();
+}
+
+float MMKPChoiceSolution::getProfit() const{
+    return this->profitSummation;
+}
+
+const std::vector<float>& MMKPChoiceSolution::getCostsSummation() const{
+    return this->costsSummation;
+}
+
+float MMKPChoiceSolution::getCost(int index) const{
+    return this->costsSummation.at(index);
+}
+
+std::size_t MMKPChoiceSolution::hash() const{
+    //FNV-1a over the selected item of each class
+    std::size_t h = 14695981039346656037ULL;
+    for(std::size_t i=0;i<this->choices.size();i++){
+        h ^= (unsigned short)this->choices[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+MMKPSolution MMKPChoiceSolution::toSolution
+(const std::vector<int>& numberOfItemsPerClass) const{
+    assert(numberOfItemsPerClass.size() == this->choices.size());
+    MMKPSolution solution(numberOfItemsPerClass);
+    for(std::size_t i=0;i<this->choices.size();i++){
+        if(this->choices[i] != NO_CHOICE){
+            solution[i][this->choices[i]] = true;
+        }
+    }
+    solution.setProfit(this->profitSummation);
+    solution.setCosts(this->costsSummation);
+    return solution;
+}
+
+//mutators
+void MMKPChoiceSolution::setChoice(int classI, short itemI){
+    assert(classI<this->choices.size());
+    this->choices[classI] = itemI;
+}
+
+bool MMKPChoiceSolution::fromSolution(MMKPSolution& solution){
+    bool isLossless = true;
+    this->choices.assign(solution.size(),NO_CHOICE);
+    for(int i=0;i<solution.size();i++){
+        const std::vector<bool>& items = solution[i];
+        for(std::size_t j=0;j<items.size();j++){
+            if(!items[j]){continue;}
+            if(this->choices[i] == NO_CHOICE){
+                this->choices[i] = j;
+            }else{
+                isLossless = false;
+            }
+        }
+        if(this->choices[i] == NO_CHOICE){
+            isLossless = false;
+        }
+    }
+    this->profitSummation = solution.getProfit();
+    this->costsSummation = solution.getCostsSummation();
+    return isLossless;
+}
+
+void MMKPChoiceSolution::setCosts(const std::vector<float>& costsSummation){
+    this->costsSummation = costsSummation;
+}
+
+void MMKPChoiceSolution::setCost(const std::size_t index, float costSummation){
+    assert(index<this->costsSummation.size());
+    this->costsSummation[index] = costSummation;
+}
+
+void MMKPChoiceSolution::setProfit(const float profitSummation){
+    this->profitSummation = profitSummation;
+}
+
+//non-member functions
+std::ostream& operator<<(std::ostream& os,const MMKPChoiceSolution& obj){
+    os<<"Profit: "<<std::fixed<<std::setprecision(2)<<obj.getProfit()<<std::endl;
+    os<<"Costs: ";
+    for(std::size_t i=0;i<obj.getCostsSummation().size();i++){
+        os<<std::fixed<<std::setprecision(2)<<obj.getCost(i)<<" ";
+    }
+    os<<std::endl;
+    os<<"Choices: ";
+    for(int i=0;i<obj.size();i++){
+        os<<obj[i]<<" ";
+    }
+    os<<std::endl;
+    return os;
+}
@@ -0,0 +1,169 @@
+/*********************************************************
+ *
+ * File: MMKPChoiceSolution.h
+ * Author: Ken Zyma
+ *
+ * Compact (one item per class) MMKP Solution representation.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPChoiceSolution__
+#define ____MMKPChoiceSolution__
+
+#include <iostream>
+#include <vector>
+#include <assert.h>
+#include <iomanip>
+#include <cstddef>
+
+#include "MMKPSolution.h"
+
+/**
+ * Compact MMKP solution representation. A multiple-choice feasible solution
+ * selects exactly one item per class, so only the selected item index of
+ * each class is stored (NO_CHOICE if nothing is selected). Choices and cost
+ * summations are plain contiguous arrays, copying a solution is a memcpy of
+ * each and comparing or hashing is O(classes).
+ *
+ * Conversion to and from the bit representation (class: MMKPSolution) is
+ * lossless for multiple-choice feasible solutions.
+ */
+class MMKPChoiceSolution{
+
+private:
+    std::vector<short> choices;
+    float profitSummation;
+    std::vector<float> costsSummation;
+public:
+    /**
+     * Value used for a class with no item selected.
+     */
+    static const short NO_CHOICE = -1;
+
+    /**
+     * Construct empty MMKPChoiceSolution.
+     */
+    MMKPChoiceSolution();
+
+    /**
+     * Construct MMKPChoiceSolution with numberOfClasses classes, none
+     * selected. Constraints (costs) are initialized to 0.
+     */
+    MMKPChoiceSolution(int numberOfClasses, int numberOfConstraints);
+
+    /**
+     * Construct MMKPChoiceSolution from the bit representation. Profit and
+     * costs are copied as is. See fromSolution.
+     */
+    explicit MMKPChoiceSolution(MMKPSolution& solution);
+
+    //operator overloading
+    /**
+     * Return selected item index of a class (NO_CHOICE if none).
+     */
+    short operator[](int index) const;
+
+    /**
+     * Compare two MMKPChoiceSolutions, equality based on the items selected.
+     */
+    bool operator==(const MMKPChoiceSolution& other) const;
+
+    bool operator!=(const MMKPChoiceSolution& other) const;
+
+    //accessors
+    /**
+     * Return number of class's in a MMKPChoiceSolution.
+     */
+    int size() const;
+
+    /**
+     * Return profit of a MMKPChoiceSolution. *note* like MMKPSolution this
+     * is not updated automatically when a choice changes.
+     */
+    float getProfit() const;
+
+    /**
+     * Return costs of constraints for MMKPChoiceSolution.
+     */
+    const std::vector<float>& getCostsSummation() const;
+
+    /**
+     * Return cost summation for the cost contratint at corresponding index.
+     */
+    float getCost(int index) const;
+
+    /**
+     * Return hash of the selected items, equal solutions hash equally.
+     */
+    std::size_t hash() const;
+
+    /**
+     * Convert to bit representation. Param: numberOfItemsPerClass gives
+     * the size of each class (ex. MMKPDataSet::getSizeOfEachClass).
+     */
+    MMKPSolution toSolution(const std::vector<int>& numberOfItemsPerClass) const;
+
+    //mutators
+    /**
+     * Set selected item of class classI.
+     */
+    void setChoice(int classI, short itemI);
+
+    /**
+     * Set choices from the bit representation, profit and costs are copied.
+     * Return true if the conversion was lossless (exactly one item in each
+     * class selected). If more than one is selected the first is kept, if
+     * none are selected the class is set to NO_CHOICE.
+     */
+    bool fromSolution(MMKPSolution& solution);
+
+    /**
+     * Set cost constraints for a solution.
+     */
+    void setCosts(const std::vector<float>& costsSummation);
+
+    /**
+     * Set a single cost constraint for solution given by param: index.
+     */
+    void setCost(const std::size_t index, float costSummation);
+
+    /**
+     * Set profit for a solution.
+     */
+    void setProfit(const float profitSummation);
+};
+
+/**
+ * Hash function object, for use with unordered containers.
+ */
+struct MMKPChoiceSolutionHash{
+    std::size_t operator()(const MMKPChoiceSolution& solution) const{
+        return solution.hash();
+    }
+};
+
+std::ostream& operator<<(std::ostream& os,const MMKPChoiceSolution& obj);
+
+#endif /* defined(____MMKPChoiceSolution__) */
@@ -0,0 +1,81 @@
+/******************************************************************
+ *
+ * File: MMKPConvert.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Converts Or-Lib and Hiremath/Hill text problem files to the binary
+ * format (see MMKPBinary.h). Takes command line arguments folder followed
+ * by one or more files, each file is written to [folder]/[file].mmkp,
+ * where HeuristicApp and MmhphApp pick it up instead of the text file.
+ *
+ *     ./MMKPConvert [data folder] [file] [file] ...
+ *
+ * ex:
+ *
+ *     ./MMKPConvert orlib_data I01 I02 I03
+ *
+ *******************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MMKPDataSet.h"
+#include "MMKPBinary.h"
+
+int main(int argc, char* argv[]){
+
+    if(argc < 3){
+        std::cout<<"usage: MMKPConvert <folder><name> [<name> ...]\n";
+        return 0;
+    }
+    std::string folder = argv[1];
+    if((folder!="orlib_data") && (folder!="HiremathHill_data")){
+        std::cout<<"Error, unrecognized folder name."<<std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for(int f=2;f<argc;f++){
+        std::string file = argv[f];
+        std::ifstream fileStream((folder+std::string("/")+file).c_str());
+        if(!fileStream.is_open()){
+            std::cerr<<std::string("File ")+file+std::string(" failed to open.")
+            <<std::endl;
+            failures++;
+            continue;
+        }
+
+        std::vector<MMKPDataSet> dataSets;
+        std::vector<int> problemNumbers;
+        if(folder=="orlib_data"){
+            OrLib_Read readInput;
+            dataSets.push_back(readInput(fileStream));
+            problemNumbers.push_back(1);
+        }else{
+            //read every problem in the file, one after another
+            HiremathHill_Read readInput;
+            readInput.forEach(fileStream,[&](int problemNumber,
+                                             MMKPDataSet& dataSet){
+                dataSets.push_back(dataSet);
+                problemNumbers.push_back(problemNumber);
+            });
+        }
+        fileStream.close();
+
+        std::string outName = folder+std::string("/")+file+MMKP_BINARY_EXTENSION;
+        MMKPBinary_Write writeOutput;
+        if(writeOutput(outName,dataSets,problemNumbers)){
+            std::cout<<outName<<": "<<dataSets.size()<<" problem(s)"<<std::endl;
+        }else{
+            std::cerr<<std::string("File ")+outName+
+                std::string(" failed to write.")<<std::endl;
+            failures++;
+        }
+    }
+    return (failures==0) ? 0 : 1;
+}
@@ -12,6 +12,9 @@
 
 #include "MMKPDataSet.h"
 
+#include <cctype>
+#include <sys/stat.h>
+
 /* ITEM DATA */
 
 /* value semantics */
@@ -87,15 +90,15 @@ float ItemData::getConstraintUsePercent() const{
     return this->constraintUsePercentSum;
 }
 
-float ItemData::getConstraintUsePercent(int index){
+float ItemData::getConstraintUsePercent(int index) const{
     return this->constraintUsePercent.at(index);
 }
 
-float ItemData::getProfitConstraintUsePercent(int index){
+float ItemData::getProfitConstraintUsePercent(int index) const{
     return this->profitConstraintRatio.at(index);
 }
 
-float ItemData::getConstraintUsePercent(std::vector<int> indices){
+float ItemData::getConstraintUsePercent(std::vector<int> indices) const{
     float sum = 0;
     for(int i=0;i<indices.size();i++){
         sum += constraintUsePercent.at(indices[i]);
@@ -159,43 +162,70 @@ std::ostream& operator<<(std::ostream& os, const ItemData& obj){
 /* MMKPDataSet */
 
 //value semantics
-MMKPDataSet::MMKPDataSet(){}
+MMKPDataSet::MMKPDataSet():instance(std::make_shared<Instance>()){}
 
 MMKPDataSet::MMKPDataSet(std::vector<int> numberOfItemsPerClass,
-            std::vector<float> constraints){
+            std::vector<float> constraints)
+:instance(std::make_shared<Instance>()){
     //alloc constainers
     for(std::size_t i=0;i<numberOfItemsPerClass.size();i++){
         std::vector<ItemData> temp(numberOfItemsPerClass[i]
                                       ,ItemData());
-        this->classList.push_back(temp);
+        this->instance->classList.push_back(temp);
+    }
+    this->instance->resources = constraints;
+    this->instance->numberOfItemsInClasses = numberOfItemsPerClass;
+    MMKPDataSet::pack();
+}
+
+MMKPDataSet::MMKPDataSet(const MMKPFlatData& flatData)
+:instance(std::make_shared<Instance>()){
+    this->instance->flatData = flatData;
+    const int numberOfResources = flatData.getNumberOfResources();
+    this->instance->resources.assign(flatData.getResources(),
+                           flatData.getResources()+numberOfResources);
+    for(int i=0;i<flatData.getNumberOfClasses();i++){
+        const int classSize = flatData.getClassSize(i);
+        std::vector<ItemData> temp;
+        temp.reserve(classSize);
+        for(int j=0;j<classSize;j++){
+            const int item = flatData.getItemIndex(i,j);
+            const float* costs = flatData.getCosts(item);
+            temp.push_back(ItemData(flatData.getProfit(item),
+                    std::vector<float>(costs,costs+numberOfResources),
+                    this->instance->resources));
+        }
+        this->instance->classList.push_back(temp);
+        this->instance->numberOfItemsInClasses.push_back(classSize);
     }
-    this->resources = constraints;
-    this->numberOfItemsInClasses = numberOfItemsPerClass;
 }
 
 //overloaded operators
-std::vector<ItemData>& MMKPDataSet::operator[](int index){
-    assert(index<this->classList.size());
-    return this->classList.at(index);
+const std::vector<ItemData>& MMKPDataSet::operator[](int index) const{
+    assert(index<this->instance->classList.size());
+    return this->instance->classList[index];
 }
 
 //non-member functions
-std::ostream& operator<<(std::ostream& os, MMKPDataSet& obj){
+std::ostream& operator<<(std::ostream& os, const MMKPDataSet& obj){
     
     //print resource's
     std::cout<<"Resources: ";
-    for(std::vector<float>::iterator it=obj.resources.begin();
-        it<obj.resources.end();it++){
+    const std::vector<float>& resources = obj.instance->resources;
+    for(std::vector<float>::const_iterator it=resources.begin();
+        it<resources.end();it++){
         std::cout<<*it<<" ";
     }
     std::cout<<std::endl<<std::endl;
     
     //walk through and print each item in each class.
-    for(std::vector<std::vector<ItemData> >::iterator it=obj.classList.begin();
-        it<obj.classList.end();it++){
+    const std::vector<std::vector<ItemData> >& classList = obj.instance->classList;
+    for(std::vector<std::vector<ItemData> >::const_iterator it=classList.begin();
+        it<classList.end();it++){
         std::cout<<"Class "<<
-            distance(obj.classList.begin(),it)<<" data:"<<std::endl;
-        for(std::vector<ItemData>::iterator jt=(*it).begin();jt<(*it).end();jt++){
+            distance(classList.begin(),it)<<" data:"<<std::endl;
+        for(std::vector<ItemData>::const_iterator jt=(*it).begin();
+            jt<(*it).end();jt++){
             std::cout<<*jt<<std::endl<<std::endl;
         }
     }
@@ -203,104 +233,295 @@ std::ostream& operator<<(std::ostream& os, MMKPDataSet& obj){
 }
 
 //accessors
-std::size_t MMKPDataSet::size(){
-    return this->classList.size();
+std::size_t MMKPDataSet::size() const{
+    return this->instance->classList.size();
 }
 
-std::vector<int> MMKPDataSet::getSizeOfEachClass(){
-    return this->numberOfItemsInClasses;
+const std::vector<int>& MMKPDataSet::getSizeOfEachClass() const{
+    return this->instance->numberOfItemsInClasses;
 }
 
-int MMKPDataSet::getNumberOfResources(){
-    return this->resources.size();
+int MMKPDataSet::getNumberOfResources() const{
+    return this->instance->resources.size();
 }
 
-std::vector<float> MMKPDataSet::getResources(){
-    return this->resources;
+const std::vector<float>& MMKPDataSet::getResources() const{
+    return this->instance->resources;
 }
 
-float MMKPDataSet::getResource(int index){
-    assert(index<this->resources.size());
-    return this->resources.at(index);
+float MMKPDataSet::getResource(int index) const{
+    assert(index<this->instance->resources.size());
+    return this->instance->resources[index];
+}
+
+const MMKPFlatData& MMKPDataSet::getFlatData() const{
+    return this->instance->flatData;
 }
 
 //mutators
+std::vector<ItemData>& MMKPDataSet::getMutableClass(int index){
+    assert(index<this->instance->classList.size());
+    MMKPDataSet::detach();
+    return this->instance->classList[index];
+}
+
 void MMKPDataSet::setResources(const std::vector<float> resources){
-    this->resources = resources;
+    MMKPDataSet::detach();
+    this->instance->resources = resources;
+    MMKPDataSet::pack();
+}
+
+void MMKPDataSet::pack(){
+    MMKPDataSet::detach();
+    MMKPFlatData temp(this->instance->numberOfItemsInClasses,this->instance->resources);
+    for(std::size_t i=0;i<this->instance->classList.size();i++){
+        for(std::size_t j=0;j<this->instance->classList[i].size();j++){
+            const ItemData& item = this->instance->classList[i][j];
+            temp.setItem(i,j,item.getProfit(),item.getCosts());
+        }
+    }
+    temp.setAnalytics();
+    this->instance->flatData = temp;
 }
 
 //solution helpers
-bool MMKPDataSet::isFeasible(MMKPSolution solution)const{
-    if((MMKPDataSet::isMultiChoiceFeasible(solution)) &&
-        (MMKPDataSet::isMultiDimFeasible(solution))){
-        return true;
-    }else{
-        return false;
+/**
+ * Violation mask of the calling thread, at least param: numberOfWords long.
+ * Threads share a data set, so the mask can not be a member. It only grows,
+ * so feasibility checks do not allocate once it fits the instance.
+ */
+static uint64_t* getScratchMask(int numberOfWords){
+    static thread_local std::vector<uint64_t> mask;
+    if(mask.size() < (std::size_t)numberOfWords){
+        mask.resize(numberOfWords);
     }
+    return mask.data();
 }
 
-std::vector<int> MMKPDataSet::getOffendingIndices(MMKPSolution solution) const{
+bool MMKPDataSet::isFeasible(const MMKPSolution& solution) const{
+    return (MMKPDataSet::isMultiChoiceFeasible(solution) &&
+            MMKPDataSet::isMultiDimFeasible(solution));
+}
+
+std::vector<int> MMKPDataSet::getOffendingIndices(const MMKPSolution& solution) const{
+    const int numberOfResources = this->instance->resources.size();
+    std::vector<uint64_t> violated(std::max(1,(numberOfResources+63)/64));
     std::vector<int> temp;
-    
-    std::vector<float> cSum = solution.getCostsSummation();
-    
-    for(int i=0;i<cSum.size();i++){
-        if(this->resources.at(i) < cSum.at(i)){
+    if(MMKPDataSet::getViolations(solution,violated.data()) == 0){
+        return temp;
+    }
+    for(int i=0;i<numberOfResources;i++){
+        if((violated[i/64]>>(i%64)) & 1){
             temp.push_back(i);
         }
     }
     return temp;
 }
 
-bool MMKPDataSet::isMultiChoiceFeasible(MMKPSolution solution)const{
-    bool isFeasible = true;
-    for(std::size_t i=0;i<this->classList.size();i++){
-        bool isSelected = false;
-        for(std::size_t j=0;j<this->classList[i].size();j++){
-            if((solution[i].at(j)) && (!isSelected)){
-                isSelected = true;
-            }else if((solution[i].at(j)) && (isSelected)){
-                return false;
-            }else{}
+int MMKPDataSet::getViolations(const MMKPSolution& solution,
+                               uint64_t* violated) const{
+    const int numberOfResources = this->instance->resources.size();
+    int count = 0;
+    uint64_t cachedViolated = 0;
+    if(solution.getCachedViolations(count,cachedViolated) &&
+       ((violated == NULL) || (count == 0) ||
+        (numberOfResources <= SOLUTION_CACHED_RESOURCES))){
+        if(violated != NULL){
+            std::fill(violated,violated+(numberOfResources+63)/64,0);
+            if(numberOfResources > 0){violated[0] = cachedViolated;}
         }
-        //check if none from class is selected
-        if(!isSelected){
+        return count;
+    }
+    
+    const std::vector<float>& constraints = solution.getCostsSummation();
+    assert(constraints.size() >= numberOfResources);
+    uint64_t* mask = (violated != NULL) ? violated :
+        getScratchMask((numberOfResources+63)/64+1);
+    count = compareCosts(constraints.data(),this->instance->resources.data(),
+                         numberOfResources,mask);
+    solution.setCachedViolations(count,(count == 0) ? 0 : mask[0]);
+    return count;
+}
+
+bool MMKPDataSet::isMultiChoiceFeasible(const MMKPSolution& solution) const{
+    bool isFeasible = false;
+    if(solution.getCachedMultiChoice(isFeasible)){
+        return isFeasible;
+    }
+    for(std::size_t i=0;i<this->instance->classList.size();i++){
+        const std::vector<bool>& items = solution[i];
+        assert(items.size() == this->instance->classList[i].size());
+        int numberSelected = 0;
+        for(std::size_t j=0;j<items.size();j++){
+            numberSelected += items[j];
+        }
+        //exactly one from each class
+        if(numberSelected != 1){
+            solution.setCachedMultiChoice(false);
             return false;
         }
     }
+    solution.setCachedMultiChoice(true);
     return true;
 }
 
-bool MMKPDataSet::isMultiDimFeasible(MMKPSolution solution)const{
-    std::vector<float> constraints(solution.getCostsSummation());
-    for(std::size_t i=0;i<this->resources.size();i++){
-        if(constraints.at(i) > this->resources.at(i)){
-            return false;
-        }
-    }
-    return true;
+bool MMKPDataSet::isMultiDimFeasible(const MMKPSolution& solution) const{
+    return (MMKPDataSet::getViolations(solution,NULL) == 0);
 }
 
-void MMKPDataSet::updateSolution(MMKPSolution& solution){
-    std::vector<float> cSum(resources.size(),0);
+void MMKPDataSet::updateSolution(MMKPSolution& solution) const{
+    const MMKPFlatData& flatData = this->instance->flatData;
+    const MMKPSolution& selection = solution;   //reading keeps the cache
+    solution.clearCosts(flatData.getNumberOfResources());
     float profit = 0;
     for(std::size_t i=0;i<solution.size();i++){
-        for(std::size_t j=0;j<solution[i].size();j++){
-            if(solution[i].at(j)){
-                profit += (this->classList.at(i)).at(j).getProfit();
+        const std::vector<bool>& items = selection[i];
+        const int offset = flatData.getClassOffset(i);
+        for(std::size_t j=0;j<items.size();j++){
+            if(items[j]){
                 //get sum of contraints && profit
-                std::vector<float> temp((this->classList.at(i).at(j)).getCosts());
-                for(std::size_t k=0;k<temp.size();k++){
-                    cSum[k] += temp[k];
-                }
+                profit += flatData.getProfit(offset+j);
+                solution.addCosts(flatData.getCosts(offset+j));
             }
         }
     }
     solution.setProfit(profit);
+}
+
+void MMKPDataSet::swapItem(MMKPSolution& solution, int classI,
+                           int fromItem, int toItem) const{
+    if(fromItem == toItem){return;}
+    
+    const int numberOfResources = this->instance->flatData.getNumberOfResources();
+    const int from = this->instance->flatData.getItemIndex(classI,fromItem);
+    const int to = this->instance->flatData.getItemIndex(classI,toItem);
+    std::vector<bool>& items = solution[classI];
+    
+    //only count what actually changes, so extra selected items
+    //in a class do not corrupt the summations
+    float profit = solution.getProfit();
+    if(items[fromItem]){
+        const float* costs = this->instance->flatData.getCosts(from);
+        for(int k=0;k<numberOfResources;k++){
+            solution.setCost(k,solution.getCost(k)-costs[k]);
+        }
+        profit -= this->instance->flatData.getProfit(from);
+        items[fromItem] = false;
+    }
+    if(!items[toItem]){
+        const float* costs = this->instance->flatData.getCosts(to);
+        for(int k=0;k<numberOfResources;k++){
+            solution.setCost(k,solution.getCost(k)+costs[k]);
+        }
+        profit += this->instance->flatData.getProfit(to);
+        items[toItem] = true;
+    }
+    solution.setProfit(profit);
+}
+
+MMKPSwapDelta MMKPDataSet::peekSwap(const MMKPSolution& solution, int classI,
+                                    int fromItem, int toItem) const{
+    const int numberOfResources = this->instance->flatData.getNumberOfResources();
+    const int from = this->instance->flatData.getItemIndex(classI,fromItem);
+    const int to = this->instance->flatData.getItemIndex(classI,toItem);
+    const float* fromCosts = this->instance->flatData.getCosts(from);
+    const float* toCosts = this->instance->flatData.getCosts(to);
+    
+    MMKPSwapDelta delta;
+    delta.profitDelta = this->instance->flatData.getProfit(to) - this->instance->flatData.getProfit(from);
+    delta.isMultiDimFeasible = true;
+    for(int k=0;k<numberOfResources;k++){
+        float newCost = solution.getCost(k) - fromCosts[k] + toCosts[k];
+        if(newCost > this->instance->resources[k]){
+            delta.isMultiDimFeasible = false;
+            break;
+        }
+    }
+    return delta;
+}
+
+void MMKPDataSet::swapItem(MMKPChoiceSolution& solution, int classI,
+                           int toItem) const{
+    const int fromItem = solution[classI];
+    if(fromItem == toItem){return;}
+    
+    const int numberOfResources = this->instance->flatData.getNumberOfResources();
+    const int to = this->instance->flatData.getItemIndex(classI,toItem);
+    const float* toCosts = this->instance->flatData.getCosts(to);
+    float profit = solution.getProfit() + this->instance->flatData.getProfit(to);
+    
+    if(fromItem != MMKPChoiceSolution::NO_CHOICE){
+        const int from = this->instance->flatData.getItemIndex(classI,fromItem);
+        const float* fromCosts = this->instance->flatData.getCosts(from);
+        for(int k=0;k<numberOfResources;k++){
+            solution.setCost(k,solution.getCost(k)-fromCosts[k]+toCosts[k]);
+        }
+        profit -= this->instance->flatData.getProfit(from);
+    }else{
+        for(int k=0;k<numberOfResources;k++){
+            solution.setCost(k,solution.getCost(k)+toCosts[k]);
+        }
+    }
+    solution.setProfit(profit);
+    solution.setChoice(classI,toItem);
+}
+
+MMKPSwapDelta MMKPDataSet::peekSwap(const MMKPChoiceSolution& solution,
+                                    int classI, int toItem) const{
+    const int numberOfResources = this->instance->flatData.getNumberOfResources();
+    const int fromItem = solution[classI];
+    const int to = this->instance->flatData.getItemIndex(classI,toItem);
+    const float* toCosts = this->instance->flatData.getCosts(to);
+    const float* fromCosts = NULL;
+    
+    MMKPSwapDelta delta;
+    delta.profitDelta = this->instance->flatData.getProfit(to);
+    if(fromItem != MMKPChoiceSolution::NO_CHOICE){
+        const int from = this->instance->flatData.getItemIndex(classI,fromItem);
+        fromCosts = this->instance->flatData.getCosts(from);
+        delta.profitDelta -= this->instance->flatData.getProfit(from);
+    }
+    delta.isMultiDimFeasible = true;
+    for(int k=0;k<numberOfResources;k++){
+        float newCost = solution.getCost(k) + toCosts[k];
+        if(fromCosts != NULL){
+            newCost -= fromCosts[k];
+        }
+        if(newCost > this->instance->resources[k]){
+            delta.isMultiDimFeasible = false;
+            break;
+        }
+    }
+    return delta;
+}
+
+void MMKPDataSet::updateSolution(MMKPChoiceSolution& solution) const{
+    const int numberOfResources = this->instance->flatData.getNumberOfResources();
+    std::vector<float> cSum(numberOfResources,0);
+    float profit = 0;
+    for(int i=0;i<solution.size();i++){
+        if(solution[i] == MMKPChoiceSolution::NO_CHOICE){continue;}
+        const int item = this->instance->flatData.getItemIndex(i,solution[i]);
+        profit += this->instance->flatData.getProfit(item);
+        addCosts(cSum.data(),this->instance->flatData.getCosts(item),
+                 numberOfResources);
+    }
+    solution.setProfit(profit);
     solution.setCosts(cSum);
 }
 
-float MMKPDataSet::getVariableConstraintUseDiff(MMKPSolution& solution){
+bool MMKPDataSet::isFeasible(const MMKPChoiceSolution& solution) const{
+    for(int i=0;i<solution.size();i++){
+        if(solution[i] == MMKPChoiceSolution::NO_CHOICE){
+            return false;
+        }
+    }
+    const std::vector<float>& constraints = solution.getCostsSummation();
+    return (compareCosts(constraints.data(),this->instance->resources.data(),
+                         this->instance->resources.size(),NULL) == 0);
+}
+
+float MMKPDataSet::getVariableConstraintUseDiff(MMKPSolution& solution) const{
     std::vector<int> offI = MMKPDataSet::getOffendingIndices(solution);
     float tempCost = 0;
     float tempResource = 0;
@@ -315,6 +536,13 @@ float MMKPDataSet::getVariableConstraintUseDiff(MMKPSolution& solution){
     return (1-(tempResource/tempCost));
 }
 
+//private helpers
+void MMKPDataSet::detach(){
+    if(this->instance.use_count() > 1){
+        this->instance = std::make_shared<Instance>(*this->instance);
+    }
+}
+
 /* ORLIB_READ */
 MMKPDataSet OrLib_Read::operator()(std::ifstream& file){
     //read general problem data
@@ -355,69 +583,230 @@ MMKPDataSet OrLib_Read::operator()(std::ifstream& file){
             }
             //add to dataSet
             ItemData temp(profit,constraints,resources);
-            dataSet[i][j] = temp;
+            dataSet.getMutableClass(i)[j] = temp;
         }
     }
+    dataSet.pack();
     
     return dataSet;
 }
 
 
+/**
+ * Skip count whitespace separated tokens of file without converting them.
+ * Sets failbit if the end of file is reached first.
+ */
+static void skipTokens(std::istream& file, long long count){
+    std::streambuf* buf = file.rdbuf();
+    int c = buf->sgetc();
+    for(long long i=0;i<count;i++){
+        while((c != EOF) && isspace(c)){
+            c = buf->snextc();
+        }
+        if(c == EOF){
+            file.setstate(std::ios::eofbit|std::ios::failbit);
+            return;
+        }
+        while((c != EOF) && !isspace(c)){
+            c = buf->snextc();
+        }
+    }
+}
+
+/**
+ * Get size and modification time of file fileName. Return false if it
+ * does not exist.
+ */
+static bool getFileStamp(const std::string& fileName, long long& size,
+                         long long& modified){
+    struct stat fileStat;
+    if(stat(fileName.c_str(),&fileStat) != 0){
+        return false;
+    }
+    size = fileStat.st_size;
+    modified = fileStat.st_mtime;
+    return true;
+}
+
+/* HiremathHill_Index */
+
+HiremathHill_Index::HiremathHill_Index():fileSize(-1),fileModified(-1){}
+
+int HiremathHill_Index::size() const{
+    return this->problemNumbers.size();
+}
+
+std::streamoff HiremathHill_Index::getOffset(int problemNumber) const{
+    for(std::size_t i=0;i<this->problemNumbers.size();i++){
+        if(this->problemNumbers[i] == problemNumber){
+            return this->offsets[i];
+        }
+    }
+    return -1;
+}
+
+bool HiremathHill_Index::build(const std::string& fileName){
+    this->problemNumbers.clear();
+    this->offsets.clear();
+    if(!getFileStamp(fileName,this->fileSize,this->fileModified)){
+        return false;
+    }
+    std::ifstream file(fileName.c_str());
+    if(!file.is_open()){
+        return false;
+    }
+    
+    int problemNumber,classSize,itemsPerClassSize,resourceSize;
+    while(true){
+        file>>std::ws;
+        std::streamoff offset = file.tellg();
+        if(!(file>>problemNumber>>classSize>>itemsPerClassSize>>resourceSize)){
+            break;
+        }
+        //resources, then each class number and items (profit + costs)
+        skipTokens(file,resourceSize+(long long)classSize*
+                   (1+(long long)itemsPerClassSize*(1+resourceSize)));
+        if(file.fail()){
+            return false;
+        }
+        this->problemNumbers.push_back(problemNumber);
+        this->offsets.push_back(offset);
+    }
+    return true;
+}
+
+bool HiremathHill_Index::load(const std::string& fileName,
+                              const std::string& indexFileName){
+    long long currentSize,currentModified;
+    if(!getFileStamp(fileName,currentSize,currentModified)){
+        return false;
+    }
+    std::ifstream file(indexFileName.c_str());
+    if(!file.is_open()){
+        return false;
+    }
+    std::string tag;
+    int version,numberOfProblems;
+    file>>tag>>version>>this->fileSize>>this->fileModified>>numberOfProblems;
+    if(file.fail() || (tag != "HHINDEX") || (version != 1) ||
+       (this->fileSize != currentSize) || (this->fileModified != currentModified)){
+        return false;
+    }
+    this->problemNumbers.resize(numberOfProblems);
+    this->offsets.resize(numberOfProblems);
+    for(int i=0;i<numberOfProblems;i++){
+        long long offset;
+        file>>this->problemNumbers[i]>>offset;
+        this->offsets[i] = offset;
+    }
+    return !file.fail();
+}
+
+bool HiremathHill_Index::save(const std::string& indexFileName) const{
+    std::ofstream file(indexFileName.c_str());
+    if(!file.is_open()){
+        return false;
+    }
+    file<<"HHINDEX 1 "<<this->fileSize<<" "<<this->fileModified<<" "
+        <<this->problemNumbers.size()<<std::endl;
+    for(std::size_t i=0;i<this->problemNumbers.size();i++){
+        file<<this->problemNumbers[i]<<" "<<(long long)this->offsets[i]<<std::endl;
+    }
+    file.close();
+    return !file.fail();
+}
+
+/* HiremathHill_Read */
+
+const std::string HiremathHill_Read::INDEX_EXTENSION = ".idx";
+
 MMKPDataSet HiremathHill_Read::operator()(std::ifstream& file,int problemToRun){
+    int problemNumber;
+    MMKPDataSet dataSet;
+    do{
+        dataSet = HiremathHill_Read::readProblem(file,problemNumber,problemToRun);
+    }while((problemNumber != problemToRun) && (!file.fail()));
+    return dataSet;
+}
+
+MMKPDataSet HiremathHill_Read::operator()(std::ifstream& file,int problemToRun,
+                                          const std::string& fileName){
+    std::string indexFileName = fileName+INDEX_EXTENSION;
+    HiremathHill_Index index;
+    if(!index.load(fileName,indexFileName)){
+        if(index.build(fileName)){
+            index.save(indexFileName);
+        }
+    }
     
+    std::streamoff offset = index.getOffset(problemToRun);
+    file.clear();
+    file.seekg((offset<0) ? 0 : offset);
+    return HiremathHill_Read::operator()(file,problemToRun);
+}
+
+void HiremathHill_Read::forEach(std::ifstream& file,
+        const std::function<void(int, MMKPDataSet&)>& callback){
+    int problemNumber;
+    while(true){
+        MMKPDataSet dataSet = HiremathHill_Read::readProblem(file,problemNumber,-1);
+        if(file.fail()){
+            break;
+        }
+        callback(problemNumber,dataSet);
+    }
+}
+
+MMKPDataSet HiremathHill_Read::readProblem(std::istream& file,int& problemNumber,
+                                           int problemToRun){
     //read general problem data
     int classSize;
     int itemsPerClassSize;
     int resourceSize;
     std::vector<float> resources;
     int buffer;
-    int problemNumber;
-    MMKPDataSet dataSet;
     
-    do{
-        resources.clear();
-        file>>problemNumber;
-        file>>classSize;
-        file>>itemsPerClassSize;
-        //these problems are all equal number of items in each class,
-        //so fill vector with same data to pass into MMKPDataSet
-        std::vector<int> itemsPerClass(classSize,itemsPerClassSize);
-        file>>resourceSize;
-        
-        for(std::size_t i=0;i<resourceSize;i++){
-            file>>buffer;
-            resources.push_back(buffer);
-        }
-        //add to dataset
-        MMKPDataSet temp(itemsPerClass,resources);
-        dataSet = temp;
-        
-        //read each class information
-        //for each class
-        for(std::size_t i=0;i<classSize;i++){
-            file>>buffer;   //eat each class number
-            //for each item in each class
-            for(std::size_t j=0;j<itemsPerClass[i];j++){
-                //for each constraint
-                float profit;
-                std::vector<float> constraints;
-                file>>profit;
-                for(std::size_t k=0;k<resourceSize;k++){
-                    file>>buffer;
-                    constraints.push_back(buffer);
-                }
-                //add to dataSet
-                ItemData temp(profit,constraints,resources);
-                dataSet[i][j] = temp;
+    problemNumber = -1;
+    if(!(file>>problemNumber>>classSize>>itemsPerClassSize>>resourceSize)){
+        return MMKPDataSet();
+    }
+    //skip over problems that are not asked for
+    if((problemToRun != -1) && (problemNumber != problemToRun)){
+        skipTokens(file,resourceSize+(long long)classSize*
+                   (1+(long long)itemsPerClassSize*(1+resourceSize)));
+        return MMKPDataSet();
+    }
+    //these problems are all equal number of items in each class,
+    //so fill vector with same data to pass into MMKPDataSet
+    std::vector<int> itemsPerClass(classSize,itemsPerClassSize);
+    
+    for(std::size_t i=0;i<resourceSize;i++){
+        file>>buffer;
+        resources.push_back(buffer);
+    }
+    //add to dataset
+    MMKPDataSet dataSet(itemsPerClass,resources);
+    
+    //read each class information
+    //for each class
+    for(std::size_t i=0;i<classSize;i++){
+        file>>buffer;   //eat each class number
+        //for each item in each class
+        for(std::size_t j=0;j<itemsPerClass[i];j++){
+            //for each constraint
+            float profit;
+            std::vector<float> constraints;
+            file>>profit;
+            for(std::size_t k=0;k<resourceSize;k++){
+                file>>buffer;
+                constraints.push_back(buffer);
             }
+            //add to dataSet
+            ItemData temp(profit,constraints,resources);
+            dataSet.getMutableClass(i)[j] = temp;
         }
-    }while(problemNumber != problemToRun);
+    }
+    dataSet.pack();
     
     return dataSet;
 }
-
-
-
-
-
-
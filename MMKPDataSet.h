@@ -36,9 +36,13 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <functional>
+#include <memory>
 #include <assert.h>
 
 #include "MMKPSolution.h"
+#include "MMKPChoiceSolution.h"
+#include "MMKPFlatData.h"
 
 /**
  * Item in MMKP, which consists of a profit and cost
@@ -109,19 +113,19 @@ public:
     /*
      * Return Er%/n for one constraint of an ItemData.
      */
-    float getConstraintUsePercent(int index);
+    float getConstraintUsePercent(int index) const;
     
     /*
      * Return v/[Er%/n] for one constraint of an ItemData.
      */
-    float getProfitConstraintUsePercent(int index);
+    float getProfitConstraintUsePercent(int index) const;
     
     /*
      * Return Er%/n for select constraints of an ItemData.
      * Param: indices are indices to get summation, order
      * does not matter.
      */
-    float getConstraintUsePercent(std::vector<int> indices);
+    float getConstraintUsePercent(std::vector<int> indices) const;
     
     //mutators
     /**
@@ -146,16 +150,44 @@ public:
 std::ostream& operator<<(std::ostream& os, const ItemData& obj);
 
 
+/**
+ * Result of evaluating an item swap without applying it (see
+ * MMKPDataSet::peekSwap).
+ */
+typedef struct{
+    float profitDelta;          //new profit - current profit
+    bool isMultiDimFeasible;    //true if no resource is over-used after swap
+}MMKPSwapDelta;
+
 /**
  * MMKP data consisting of classes with items (class: ItemData) 
- * and available resources.
+ * and available resources. A contiguous copy of the items (class:
+ * MMKPFlatData) is kept alongside for the solution helpers and other
+ * hot loops.
+ *
+ * MMKPDataSet is a handle, copies share one instance of the data, so
+ * passing it by value is cheap and any number of threads may read it.
+ * A copy is only made when shared data is modified (see getMutableClass,
+ * setResources and pack).
  */
 class MMKPDataSet{
 
 private:
-    std::vector<std::vector<ItemData> > classList;
-    std::vector<float> resources;
-    std::vector<int> numberOfItemsInClasses;
+    /**
+     * Problem data shared by copies of a MMKPDataSet.
+     */
+    struct Instance{
+        std::vector<std::vector<ItemData> > classList;
+        std::vector<float> resources;
+        std::vector<int> numberOfItemsInClasses;
+        MMKPFlatData flatData;
+    };
+    std::shared_ptr<Instance> instance;
+    
+    /**
+     * Give this handle its own copy of the data, if it is shared.
+     */
+    void detach();
 public:
     /**
      * Construct empty MMKPDataSet.
@@ -169,77 +201,153 @@ public:
     MMKPDataSet(std::vector<int> numberOfItemsInClasses,
                 std::vector<float> constraints);
     
+    /**
+     * Construct MMKPDataSet from existing flat data (ex. a mapped binary
+     * file, see MMKPBinary.h). Items are built from it, the flat data
+     * itself is kept as is rather than re-packed.
+     */
+    explicit MMKPDataSet(const MMKPFlatData& flatData);
+    
     //operator overloading
     /**
      * Return reference to a class of items (vector<ItemData>). 
      * Usage is similar to that of a multi-dimensional array:
-     * DataSetName[classIndex][ItemIndex]
+     * DataSetName[classIndex][ItemIndex].
      */
-    std::vector<ItemData>& operator[](int index);
+    const std::vector<ItemData>& operator[](int index) const;
     
-    friend std::ostream& operator<<(std::ostream& os, MMKPDataSet& obj);
+    friend std::ostream& operator<<(std::ostream& os, const MMKPDataSet& obj);
     
     //accessors
     /**
      * Return number of classes.
      */
-    std::size_t size();
+    std::size_t size() const;
     
     /**
      * Return vector containing the number of items in each class.
      */
-    std::vector<int> getSizeOfEachClass();
+    const std::vector<int>& getSizeOfEachClass() const;
     
     /**
      * Return the number of problem constraints.
      */
-    int getNumberOfResources();
+    int getNumberOfResources() const;
     
     /**
      * Return vector containing resource constraints.
      */
-    std::vector<float> getResources();
+    const std::vector<float>& getResources() const;
     
     /**
      * Return one resource
      */
-    float getResource(int index);
+    float getResource(int index) const;
+    
+    /**
+     * Return contiguous copy of all items, as of the last call to pack.
+     */
+    const MMKPFlatData& getFlatData() const;
     
     //mutators
     /**
-     * Set problem resource constraints.
+     * Return modifiable reference to a class of items, copying the data
+     * first if it is shared. *note* items changed through this reference
+     * are not seen by the flat data until pack is called.
+     */
+    std::vector<ItemData>& getMutableClass(int index);
+    
+    /**
+     * Set problem resource constraints. The flat data is re-packed.
      */
     void setResources(const std::vector<float> resources);
     
+    /**
+     * Rebuild the flat data from the current items and resources. Must be
+     * called after items are modified through operator[].
+     */
+    void pack();
+    
     //solution helpers
     /**
      * Return true if param: solution is feasible, false
-     * otherwise.
+     * otherwise. The result is cached on the solution until its items or
+     * costs change, so checking an unchanged solution again is O(1).
      */
-    bool isFeasible(MMKPSolution solution)const;
+    bool isFeasible(const MMKPSolution& solution) const;
     
     /**
      * Return indices (if any) corresponding to resources that have
      * been over-used.
      */
-    std::vector<int> getOffendingIndices(MMKPSolution solution) const;
+    std::vector<int> getOffendingIndices(const MMKPSolution& solution) const;
+    
+    /**
+     * Return the number of resources over-used by param: solution, 0 if
+     * it is multiple-dimension feasible, and if param: violated is not
+     * NULL mark them in it (see compareCosts in MMKPKernels.h). Costs must
+     * be up to date (see updateSolution).
+     */
+    int getViolations(const MMKPSolution& solution, uint64_t* violated) const;
     
     /**
      * Return true if param: solution is feasible by
      * multiple-choice constraints.
      */
-    bool isMultiChoiceFeasible(MMKPSolution solution)const;
+    bool isMultiChoiceFeasible(const MMKPSolution& solution) const;
     
     /**
      * Return true if param: solution is feasible by
      * multiple-dimension constaints.
      */
-    bool isMultiDimFeasible(MMKPSolution solution)const;
+    bool isMultiDimFeasible(const MMKPSolution& solution) const;
     
     /**
      * Update solution analytics.
      */
-    void updateSolution(MMKPSolution& solution);
+    void updateSolution(MMKPSolution& solution) const;
+    
+    /**
+     * Swap item fromItem for item toItem in class classI, updating the
+     * solution's profit and costs incrementally in O(resources).
+     *
+     * Precondition: solution analytics must be up to date (see
+     *      updateSolution).
+     */
+    void swapItem(MMKPSolution& solution, int classI,
+                  int fromItem, int toItem) const;
+    
+    /**
+     * Return the profit change and multi-dim feasibility that swapping
+     * fromItem for toItem in class classI would result in, without
+     * modifying solution. Same precondition as swapItem.
+     */
+    MMKPSwapDelta peekSwap(const MMKPSolution& solution, int classI,
+                           int fromItem, int toItem) const;
+    
+    /**
+     * Select item toItem in class classI of a compact solution, updating
+     * profit and costs incrementally in O(resources).
+     */
+    void swapItem(MMKPChoiceSolution& solution, int classI, int toItem) const;
+    
+    /**
+     * Return the profit change and multi-dim feasibility of selecting
+     * toItem in class classI, without modifying solution.
+     */
+    MMKPSwapDelta peekSwap(const MMKPChoiceSolution& solution, int classI,
+                           int toItem) const;
+    
+    /**
+     * Update solution analytics of a compact solution.
+     */
+    void updateSolution(MMKPChoiceSolution& solution) const;
+    
+    /**
+     * Return true if param: solution is feasible, false otherwise. Costs
+     * must be up to date (see updateSolution).
+     */
+    bool isFeasible(const MMKPChoiceSolution& solution) const;
     
     /**
      * Return the percent difference of contraint use, comparing
@@ -247,7 +355,7 @@ public:
      * which are violated in a solution. Additionally, the input solution
      * must be multiple-choice feasible.
      */
-    float getVariableConstraintUseDiff(MMKPSolution& solution);
+    float getVariableConstraintUseDiff(MMKPSolution& solution) const;
 };
 
 //non-member functions
@@ -268,6 +376,53 @@ public:
     MMKPDataSet operator()(std::ifstream& file);
 };
 
+/**
+ * Byte offset of each problem in a Hiremath/Hill problem file, so that a
+ * problem can be read without parsing the ones before it. An index is
+ * built with one pass over the file (tokens are skipped, not converted)
+ * and may be cached in a sidecar file, which is discarded once the
+ * problem file's size or modification time changes.
+ */
+class HiremathHill_Index{
+    
+private:
+    std::vector<int> problemNumbers;
+    std::vector<std::streamoff> offsets;
+    long long fileSize;
+    long long fileModified;
+public:
+    /**
+     * Construct empty HiremathHill_Index.
+     */
+    HiremathHill_Index();
+    
+    /**
+     * Return number of problems in the index.
+     */
+    int size() const;
+    
+    /**
+     * Return byte offset of problem problemNumber, -1 if not in the index.
+     */
+    std::streamoff getOffset(int problemNumber) const;
+    
+    /**
+     * Build the index of problem file fileName. Return true on success.
+     */
+    bool build(const std::string& fileName);
+    
+    /**
+     * Load a sidecar written by save. Return false if it does not exist
+     * or is out of date with problem file fileName.
+     */
+    bool load(const std::string& fileName, const std::string& indexFileName);
+    
+    /**
+     * Write the index to sidecar file indexFileName. Return true on success.
+     */
+    bool save(const std::string& indexFileName) const;
+};
+
 /**
  * HiremathHill Function Object reads from HiremathHill problem
  * sets and converts to common format MMKPDataSet.
@@ -275,12 +430,43 @@ public:
 class HiremathHill_Read{
     
 public:
+    /**
+     * Extension of the index sidecar, ex. TestSet1.5GP10IT5KP.txt.idx.
+     */
+    static const std::string INDEX_EXTENSION;
+    
     /**
      * Convert input file to MMKPDataSet. Since each file in the
      * Hiremath/Hill problem set has multuple problems, a problem
-     * to run may be specified (starting at index 1).
+     * to run may be specified (starting at index 1). Problems before
+     * problemToRun are skipped over from the current position.
      */
     MMKPDataSet operator()(std::ifstream& file, int problemToRun);
+    
+    /**
+     * Convert input file to MMKPDataSet, seeking directly to problemToRun.
+     * Param: fileName is the name file was opened with, the index of the
+     * file is loaded from (or built and saved to) fileName+INDEX_EXTENSION.
+     * Falls back to reading from the start of the file if the index can
+     * not be used.
+     */
+    MMKPDataSet operator()(std::ifstream& file, int problemToRun,
+                           const std::string& fileName);
+    
+    /**
+     * Read every problem in file from the current position in one pass,
+     * calling callback(problemNumber, dataSet) for each.
+     */
+    void forEach(std::ifstream& file,
+                 const std::function<void(int, MMKPDataSet&)>& callback);
+private:
+    /**
+     * Read the problem at the current position of file, setting param:
+     * problemNumber. If problemToRun is not -1 and does not match, the
+     * problem is skipped over and an empty MMKPDataSet returned.
+     */
+    MMKPDataSet readProblem(std::istream& file, int& problemNumber,
+                            int problemToRun);
 };
 
 
@@ -0,0 +1,262 @@
+/*********************************************************
+ *
+ * File: MMKPFlatData.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPFlatData
+ *
+ *********************************************************/
+
+#include "MMKPFlatData.h"
+
+/* MMKPFlatData */
+
+//value semantics
+MMKPFlatData::MMKPFlatData():numberOfClasses(0),numberOfItems(0),
+numberOfResources(0),stride(0),classOffsets(1,0),candidateOffsets(1,0){
+    MMKPFlatData::rebase();
+}
+
+MMKPFlatData::MMKPFlatData(const std::vector<int>& numberOfItemsPerClass,
+                           const std::vector<float>& resources)
+:numberOfClasses(numberOfItemsPerClass.size()),numberOfItems(0),
+numberOfResources(resources.size()){
+
+    //round each row up to a multiple of the vector width
+    this->stride = ((numberOfResources + FLAT_DATA_STRIDE_MULTIPLE - 1)
+                    / FLAT_DATA_STRIDE_MULTIPLE) * FLAT_DATA_STRIDE_MULTIPLE;
+
+    this->classOffsets.resize(numberOfClasses+1);
+    for(int i=0;i<numberOfClasses;i++){
+        this->classOffsets[i] = numberOfItems;
+        numberOfItems += numberOfItemsPerClass[i];
+    }
+    this->classOffsets[numberOfClasses] = numberOfItems;
+
+    this->profits.resize(numberOfItems,0);
+    this->constraintUsePercentSum.resize(numberOfItems,0);
+    this->profitConstraintUsePercent.resize(numberOfItems,0);
+    this->costs.resize(numberOfItems*stride,0);
+    this->constraintUsePercent.resize(numberOfItems*stride,0);
+    this->profitConstraintRatio.resize(numberOfItems*stride,0);
+    this->resources.resize(stride,0);
+    this->dominated.resize(numberOfItems,0);
+    this->candidateOffsets.resize(numberOfClasses+1,0);
+    for(int k=0;k<numberOfResources;k++){
+        this->resources[k] = resources[k];
+    }
+    MMKPFlatData::rebase();
+}
+
+MMKPFlatData::MMKPFlatData(const std::vector<int>& classOffsets,
+                           int numberOfResources, int stride,
+                           const float* resources, const float* profits,
+                           const float* costs,
+                           std::shared_ptr<const void> backing)
+:numberOfClasses(classOffsets.size()-1),numberOfItems(classOffsets.back()),
+numberOfResources(numberOfResources),stride(stride),classOffsets(classOffsets),
+profitsData(profits),costsData(costs),resourcesData(resources),
+backing(backing){
+    assert(stride>=numberOfResources);
+    assert(stride%FLAT_DATA_STRIDE_MULTIPLE == 0);
+    assert(((std::size_t)costs)%FLAT_DATA_ALIGNMENT == 0);
+    assert(((std::size_t)resources)%FLAT_DATA_ALIGNMENT == 0);
+    
+    this->constraintUsePercentSum.resize(numberOfItems,0);
+    this->profitConstraintUsePercent.resize(numberOfItems,0);
+    this->constraintUsePercent.resize(numberOfItems*stride,0);
+    this->profitConstraintRatio.resize(numberOfItems*stride,0);
+    MMKPFlatData::setAnalytics();
+}
+
+MMKPFlatData::MMKPFlatData(const MMKPFlatData& other)
+:numberOfClasses(other.numberOfClasses),numberOfItems(other.numberOfItems),
+numberOfResources(other.numberOfResources),stride(other.stride),
+classOffsets(other.classOffsets),profits(other.profits),
+constraintUsePercentSum(other.constraintUsePercentSum),
+profitConstraintUsePercent(other.profitConstraintUsePercent),
+costs(other.costs),constraintUsePercent(other.constraintUsePercent),
+profitConstraintRatio(other.profitConstraintRatio),resources(other.resources),
+dominated(other.dominated),candidateOffsets(other.candidateOffsets),
+itemsByProfit(other.itemsByProfit),itemsByUse(other.itemsByUse),
+itemsByRatio(other.itemsByRatio),profitsData(other.profitsData),
+costsData(other.costsData),resourcesData(other.resourcesData),
+backing(other.backing){
+    if(!this->backing){
+        MMKPFlatData::rebase();
+    }
+}
+
+MMKPFlatData& MMKPFlatData::operator=(const MMKPFlatData& other){
+    if(this != &other){
+        MMKPFlatData temp(other);
+        std::swap(this->numberOfClasses,temp.numberOfClasses);
+        std::swap(this->numberOfItems,temp.numberOfItems);
+        std::swap(this->numberOfResources,temp.numberOfResources);
+        std::swap(this->stride,temp.stride);
+        this->classOffsets.swap(temp.classOffsets);
+        this->profits.swap(temp.profits);
+        this->constraintUsePercentSum.swap(temp.constraintUsePercentSum);
+        this->profitConstraintUsePercent.swap(temp.profitConstraintUsePercent);
+        this->costs.swap(temp.costs);
+        this->constraintUsePercent.swap(temp.constraintUsePercent);
+        this->profitConstraintRatio.swap(temp.profitConstraintRatio);
+        this->resources.swap(temp.resources);
+        this->dominated.swap(temp.dominated);
+        this->candidateOffsets.swap(temp.candidateOffsets);
+        this->itemsByProfit.swap(temp.itemsByProfit);
+        this->itemsByUse.swap(temp.itemsByUse);
+        this->itemsByRatio.swap(temp.itemsByRatio);
+        this->backing.swap(temp.backing);
+        //vector swap keeps buffers, so pointers stay valid
+        this->profitsData = temp.profitsData;
+        this->costsData = temp.costsData;
+        this->resourcesData = temp.resourcesData;
+    }
+    return *this;
+}
+
+//accessors
+float MMKPFlatData::getConstraintUsePercent
+(int item, const std::vector<int>& indices) const{
+    const float* row = getConstraintUsePercentRow(item);
+    float sum = 0;
+    for(std::size_t i=0;i<indices.size();i++){
+        sum += row[indices[i]];
+    }
+    sum /= indices.size();
+    return sum;
+}
+
+//mutators
+void MMKPFlatData::setItem(int classI, int itemI, float profit,
+                           const std::vector<float>& costs){
+    assert(classI<this->numberOfClasses);
+    assert(itemI<getClassSize(classI));
+    assert(costs.size()<=this->numberOfResources);
+
+    MMKPFlatData::detach();
+    int item = getItemIndex(classI,itemI);
+    this->profits[item] = profit;
+    float* row = &this->costs[item*stride];
+    for(int k=0;k<stride;k++){
+        row[k] = (k<costs.size()) ? costs[k] : 0;
+    }
+}
+
+void MMKPFlatData::setProfit(int classI, int itemI, float profit){
+    assert(classI<this->numberOfClasses);
+    assert(itemI<getClassSize(classI));
+    MMKPFlatData::detach();
+    this->profits[getItemIndex(classI,itemI)] = profit;
+}
+
+void MMKPFlatData::setAnalytics(){
+
+    //sum of availResources
+    float resourceSum = 0;
+    for(int k=0;k<numberOfResources;k++){
+        resourceSum += this->resourcesData[k];
+    }
+
+    for(int i=0;i<numberOfItems;i++){
+        const float* row = getCosts(i);
+        float* cup = &this->constraintUsePercent[i*stride];
+        float* pcr = &this->profitConstraintRatio[i*stride];
+
+        //get sum of this costs
+        float costsSum = 0;
+        for(int k=0;k<numberOfResources;k++){
+            costsSum += row[k];
+        }
+
+        //set constraintUsePercentSum Er%/n
+        this->constraintUsePercentSum[i] = (costsSum/resourceSum);
+
+        //set profitConstraintUsePercen v/[Er%/n]
+        this->profitConstraintUsePercent[i] =
+            this->profitsData[i]/this->constraintUsePercentSum[i];
+
+        for(int k=0;k<numberOfResources;k++){
+            cup[k] = (row[k]/this->resourcesData[k]);
+            pcr[k] = this->profitsData[i]/cup[k];
+        }
+    }
+    MMKPFlatData::setCandidates();
+}
+
+//private helpers
+void MMKPFlatData::setCandidates(){
+    this->dominated.assign(numberOfItems,0);
+    this->candidateOffsets.assign(numberOfClasses+1,0);
+    this->itemsByProfit.clear();
+    
+    //b dominates a if it is no worse anywhere and better somewhere,
+    //of two exact copies the lower index is kept
+    for(int i=0;i<numberOfClasses;i++){
+        this->candidateOffsets[i] = this->itemsByProfit.size();
+        for(int a=classOffsets[i];a<classOffsets[i+1];a++){
+            const float* costsA = getCosts(a);
+            for(int b=classOffsets[i];b<classOffsets[i+1];b++){
+                if((b == a) || (this->profitsData[b] < this->profitsData[a])){
+                    continue;
+                }
+                const float* costsB = getCosts(b);
+                bool isNoWorse = true;
+                bool isBetter = (this->profitsData[b] > this->profitsData[a]);
+                for(int k=0;(k<numberOfResources) && isNoWorse;k++){
+                    isNoWorse = (costsB[k] <= costsA[k]);
+                    isBetter = isBetter || (costsB[k] < costsA[k]);
+                }
+                if(isNoWorse && (isBetter || (b < a))){
+                    this->dominated[a] = 1;
+                    break;
+                }
+            }
+            if(!this->dominated[a]){
+                this->itemsByProfit.push_back(a);
+            }
+        }
+    }
+    this->candidateOffsets[numberOfClasses] = this->itemsByProfit.size();
+    this->itemsByUse = this->itemsByProfit;
+    this->itemsByRatio = this->itemsByProfit;
+    
+    //sort each class, ties keep the lower index first
+    for(int i=0;i<numberOfClasses;i++){
+        const int first = this->candidateOffsets[i];
+        const int last = this->candidateOffsets[i+1];
+        std::stable_sort(this->itemsByProfit.begin()+first,
+                         this->itemsByProfit.begin()+last,[this](int a, int b){
+            return (this->profitsData[a] > this->profitsData[b]);
+        });
+        std::stable_sort(this->itemsByUse.begin()+first,
+                         this->itemsByUse.begin()+last,[this](int a, int b){
+            return (this->constraintUsePercentSum[a] <
+                    this->constraintUsePercentSum[b]);
+        });
+        std::stable_sort(this->itemsByRatio.begin()+first,
+                         this->itemsByRatio.begin()+last,[this](int a, int b){
+            return (this->profitConstraintUsePercent[a] >
+                    this->profitConstraintUsePercent[b]);
+        });
+    }
+}
+
+void MMKPFlatData::rebase(){
+    this->profitsData = this->profits.data();
+    this->costsData = this->costs.data();
+    this->resourcesData = this->resources.data();
+}
+
+void MMKPFlatData::detach(){
+    if(!this->backing){return;}
+    this->profits.assign(this->profitsData,this->profitsData+numberOfItems);
+    this->costs.assign(this->costsData,this->costsData+numberOfItems*stride);
+    this->resources.assign(this->resourcesData,this->resourcesData+stride);
+    this->backing.reset();
+    MMKPFlatData::rebase();
+}
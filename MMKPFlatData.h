@@ -0,0 +1,348 @@
+/***************************************************************************
+ *
+ * File: MMKPFlatData.h
+ * Author: Ken Zyma
+ *
+ * Contiguous (structure-of-arrays) storage of an MMKP problem instance.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************/
+
+#ifndef ____MMKPFlatData__
+#define ____MMKPFlatData__
+
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <assert.h>
+
+/**
+ * Byte alignment of every row in MMKPFlatData. Large enough for
+ * 256 bit vector loads.
+ */
+const std::size_t FLAT_DATA_ALIGNMENT = 32;
+
+/**
+ * Number of floats a cost row is padded to.
+ */
+const int FLAT_DATA_STRIDE_MULTIPLE = FLAT_DATA_ALIGNMENT/sizeof(float);
+
+/**
+ * Minimal allocator returning memory aligned to Alignment bytes, used
+ * so that each padded cost row of MMKPFlatData starts on a vector
+ * boundary.
+ */
+template<class T, std::size_t Alignment>
+class AlignedAllocator{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<class U>
+    struct rebind{
+        typedef AlignedAllocator<U,Alignment> other;
+    };
+
+    AlignedAllocator(){}
+
+    template<class U>
+    AlignedAllocator(const AlignedAllocator<U,Alignment>&){}
+
+    T* allocate(std::size_t n){
+        void* p = NULL;
+        if(posix_memalign(&p,Alignment,(n*sizeof(T))) != 0){
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t){
+        free(p);
+    }
+
+    template<class U>
+    bool operator==(const AlignedAllocator<U,Alignment>&) const{return true;}
+
+    template<class U>
+    bool operator!=(const AlignedAllocator<U,Alignment>&) const{return false;}
+};
+
+typedef std::vector<float,AlignedAllocator<float,FLAT_DATA_ALIGNMENT> >
+    AlignedFloatVector;
+
+/**
+ * Flat copy of the items of an MMKP problem. All items are stored back to
+ * back, item j of class i has the flat index getItemIndex(i,j). Costs (and
+ * the per-resource analytics) are stored row-major, [item][resource], with
+ * each row padded to getStride() floats. Padding entries are always 0.
+ *
+ * Analytic measures follow ItemData: Er%/n (constraint use percent summation),
+ * v/[Er%/n] (profit constraint use percent), and per resource c/r and
+ * v/(c/r).
+ *
+ * Profits, costs and resources are either owned or borrowed from an
+ * external buffer (ex. a memory mapped binary file, see MMKPBinary.h). A
+ * borrowed buffer is kept alive by a shared backing object, and is copied
+ * into owned storage the first time it is modified.
+ */
+class MMKPFlatData{
+
+private:
+    int numberOfClasses;
+    int numberOfItems;
+    int numberOfResources;
+    int stride;
+    std::vector<int> classOffsets;
+    std::vector<float> profits;
+    std::vector<float> constraintUsePercentSum;
+    std::vector<float> profitConstraintUsePercent;
+    AlignedFloatVector costs;
+    AlignedFloatVector constraintUsePercent;
+    AlignedFloatVector profitConstraintRatio;
+    AlignedFloatVector resources;
+    std::vector<char> dominated;
+    std::vector<int> candidateOffsets;  //per class, into the lists below
+    std::vector<int> itemsByProfit;
+    std::vector<int> itemsByUse;
+    std::vector<int> itemsByRatio;
+    const float* profitsData;
+    const float* costsData;
+    const float* resourcesData;
+    std::shared_ptr<const void> backing;
+    
+    /**
+     * Point profits, costs and resources at the owned arrays.
+     */
+    void rebase();
+    
+    /**
+     * Copy a borrowed buffer into owned arrays and release it.
+     */
+    void detach();
+    
+    /**
+     * Mark dominated items and sort the others of each class, see
+     * getItemsByProfit.
+     */
+    void setCandidates();
+public:
+    /**
+     * Construct empty MMKPFlatData.
+     */
+    MMKPFlatData();
+
+    /**
+     * Construct MMKPFlatData with class/item sizes and resources. All
+     * profits and costs are initialized to 0, use setItem to fill and
+     * setAnalytics once all items are set.
+     */
+    MMKPFlatData(const std::vector<int>& numberOfItemsPerClass,
+                 const std::vector<float>& resources);
+    
+    /**
+     * Construct MMKPFlatData borrowing profits, costs and resources from an
+     * external buffer, laid out as described above (costs and resources
+     * padded to stride, FLAT_DATA_ALIGNMENT aligned). Param: backing is
+     * held for the lifetime of this object (and its copies). Analytics
+     * are calculated on construction.
+     */
+    MMKPFlatData(const std::vector<int>& classOffsets, int numberOfResources,
+                 int stride, const float* resources, const float* profits,
+                 const float* costs, std::shared_ptr<const void> backing);
+    
+    MMKPFlatData(const MMKPFlatData& other);
+    
+    MMKPFlatData& operator=(const MMKPFlatData& other);
+
+    //accessors
+    /**
+     * Return number of classes.
+     */
+    int getNumberOfClasses() const{return numberOfClasses;}
+
+    /**
+     * Return number of items across all classes.
+     */
+    int getNumberOfItems() const{return numberOfItems;}
+
+    /**
+     * Return number of resources (constraints).
+     */
+    int getNumberOfResources() const{return numberOfResources;}
+
+    /**
+     * Return the number of floats in one (padded) cost row.
+     */
+    int getStride() const{return stride;}
+
+    /**
+     * Return number of items in class classI.
+     */
+    int getClassSize(int classI) const{
+        return classOffsets[classI+1] - classOffsets[classI];
+    }
+
+    /**
+     * Return flat index of the first item in class classI. Offsets are
+     * stored for numberOfClasses+1 entries, so the last entry equals
+     * getNumberOfItems().
+     */
+    int getClassOffset(int classI) const{return classOffsets[classI];}
+
+    /**
+     * Return flat index of item itemI in class classI.
+     */
+    int getItemIndex(int classI, int itemI) const{
+        return classOffsets[classI] + itemI;
+    }
+
+    /**
+     * Return profit of item at flat index item.
+     */
+    float getProfit(int item) const{return profitsData[item];}
+
+    /**
+     * Return pointer to the (padded) cost row of item at flat index item.
+     */
+    const float* getCosts(int item) const{return costsData + item*stride;}
+
+    /**
+     * Return pointer to the (padded) row of c/r values of an item.
+     */
+    const float* getConstraintUsePercentRow(int item) const{
+        return &constraintUsePercent[item*stride];
+    }
+
+    /**
+     * Return pointer to the (padded) row of v/(c/r) values of an item.
+     */
+    const float* getProfitConstraintRatioRow(int item) const{
+        return &profitConstraintRatio[item*stride];
+    }
+
+    /**
+     * Return Er%/n of an item.
+     */
+    float getConstraintUsePercent(int item) const{
+        return constraintUsePercentSum[item];
+    }
+
+    /**
+     * Return Er%/n of an item using only the resources in indices.
+     */
+    float getConstraintUsePercent(int item, const std::vector<int>& indices) const;
+
+    /**
+     * Return v/[Er%/n] of an item.
+     */
+    float getProfitConstraintUsePercent(int item) const{
+        return profitConstraintUsePercent[item];
+    }
+
+    /**
+     * Return pointer to the (padded) resource vector.
+     */
+    const float* getResources() const{return resourcesData;}
+
+    /**
+     * Return pointer to the profit array, indexed by flat index.
+     */
+    const float* getProfits() const{return profitsData;}
+    
+    /**
+     * Return true if the item at flat index item is dominated, another
+     * item of its class has at least its profit and at most its cost on
+     * every resource (and is not an exact copy with a higher index).
+     * A dominated item is never a better choice than the one dominating it.
+     */
+    bool isDominated(int item) const{return dominated[item] != 0;}
+
+    /**
+     * Return the number of items of class classI that are not dominated,
+     * the length of each of the candidate lists below.
+     */
+    int getNumberOfCandidates(int classI) const{
+        return candidateOffsets[classI+1] - candidateOffsets[classI];
+    }
+
+    /**
+     * Return the flat indices of the items of class classI that are not
+     * dominated, greatest profit first. Like the other candidate lists,
+     * ties keep the lower index first and the list is calculated by
+     * setAnalytics.
+     */
+    const int* getItemsByProfit(int classI) const{
+        return &itemsByProfit[candidateOffsets[classI]];
+    }
+
+    /**
+     * Return the candidates of class classI, lowest Er%/n first.
+     */
+    const int* getItemsByUse(int classI) const{
+        return &itemsByUse[candidateOffsets[classI]];
+    }
+
+    /**
+     * Return the candidates of class classI, greatest v/[Er%/n] first.
+     */
+    const int* getItemsByRatio(int classI) const{
+        return &itemsByRatio[candidateOffsets[classI]];
+    }
+
+    /**
+     * Return true if profits, costs and resources are borrowed from an
+     * external buffer.
+     */
+    bool isBorrowed() const{return (bool)backing;}
+
+    //mutators
+    /**
+     * Set profit and costs of item itemI in class classI. Costs shorter than
+     * the number of resources are padded with 0.
+     */
+    void setItem(int classI, int itemI, float profit,
+                 const std::vector<float>& costs);
+
+    /**
+     * Set profit of item itemI in class classI.
+     */
+    void setProfit(int classI, int itemI, float profit);
+
+    /**
+     * Calculate all analytic measures (Er%/n, v/[Er%/n], c/r, v/(c/r))
+     * and the candidate lists from the current profits, costs and
+     * resources.
+     */
+    void setAnalytics();
+};
+
+#endif /* defined(____MMKPFlatData__) */
@@ -0,0 +1,254 @@
+/*********************************************************
+ *
+ * File: MMKPKernels.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPKernels. Vector versions are compiled with
+ * target attributes, so the rest of the build needs no extra flags, and
+ * are only called when the processor supports them.
+ *
+ *********************************************************/
+
+#include "MMKPKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MMKP_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/* scalar */
+
+static void addCostsScalar(float* sum, const float* costs, int count){
+    for(int k=0;k<count;k++){
+        sum[k] += costs[k];
+    }
+}
+
+static int compareCostsScalar(const float* costs, const float* resources,
+                              int count, uint64_t* violated, int from){
+    int numberOfViolations = 0;
+    for(int k=from;k<count;k++){
+        uint64_t isViolated = (costs[k] > resources[k]);
+        numberOfViolations += isViolated;
+        if(violated != NULL){
+            violated[k/64] |= isViolated<<(k%64);
+        }
+    }
+    return numberOfViolations;
+}
+
+/**
+ * Clear the (count+63)/64 words of violated, if any.
+ */
+static void clearViolated(uint64_t* violated, int count){
+    if(violated == NULL){return;}
+    for(int w=0;w<(count+63)/64;w++){
+        violated[w] = 0;
+    }
+}
+
+#ifdef MMKP_KERNELS_X86
+
+/* avx2 */
+
+/**
+ * Return a mask selecting the first count (1 to 7) of 8 lanes.
+ */
+__attribute__((target("avx2")))
+static __m256i getTailMask(int count){
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                              _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+}
+
+__attribute__((target("avx2")))
+static void addCostsAVX2(float* sum, const float* costs, int count){
+    int k = 0;
+    for(;k+8<=count;k+=8){
+        __m256 s = _mm256_loadu_ps(sum+k);
+        _mm256_storeu_ps(sum+k,_mm256_add_ps(s,_mm256_loadu_ps(costs+k)));
+    }
+    if(k < count){
+        __m256i mask = getTailMask(count-k);
+        __m256 s = _mm256_maskload_ps(sum+k,mask);
+        _mm256_maskstore_ps(sum+k,mask,
+                            _mm256_add_ps(s,_mm256_maskload_ps(costs+k,mask)));
+    }
+}
+
+__attribute__((target("avx2,popcnt")))
+static int compareCostsAVX2(const float* costs, const float* resources,
+                            int count, uint64_t* violated){
+    clearViolated(violated,count);
+    int numberOfViolations = 0;
+    int k = 0;
+    for(;k+8<=count;k+=8){
+        __m256 isGreater = _mm256_cmp_ps(_mm256_loadu_ps(costs+k),
+                                         _mm256_loadu_ps(resources+k),
+                                         _CMP_GT_OQ);
+        uint64_t bits = (uint32_t)_mm256_movemask_ps(isGreater);
+        numberOfViolations += _mm_popcnt_u32((uint32_t)bits);
+        //8 bit groups never straddle a word, k is a multiple of 8
+        if(violated != NULL){
+            violated[k/64] |= bits<<(k%64);
+        }
+    }
+    if(k < count){
+        //masked out lanes load 0, which is never greater than 0
+        __m256i mask = getTailMask(count-k);
+        __m256 isGreater = _mm256_cmp_ps(_mm256_maskload_ps(costs+k,mask),
+                                         _mm256_maskload_ps(resources+k,mask),
+                                         _CMP_GT_OQ);
+        uint64_t bits = (uint32_t)_mm256_movemask_ps(isGreater);
+        numberOfViolations += _mm_popcnt_u32((uint32_t)bits);
+        if(violated != NULL){
+            violated[k/64] |= bits<<(k%64);
+        }
+    }
+    return numberOfViolations;
+}
+
+/* avx512 */
+
+__attribute__((target("avx512f")))
+static void addCostsAVX512(float* sum, const float* costs, int count){
+    int k = 0;
+    for(;k+16<=count;k+=16){
+        __m512 s = _mm512_loadu_ps(sum+k);
+        _mm512_storeu_ps(sum+k,_mm512_add_ps(s,_mm512_loadu_ps(costs+k)));
+    }
+    if(k < count){
+        __mmask16 mask = (1u<<(count-k))-1;
+        __m512 s = _mm512_maskz_loadu_ps(mask,sum+k);
+        _mm512_mask_storeu_ps(sum+k,mask,
+                              _mm512_add_ps(s,_mm512_maskz_loadu_ps(mask,costs+k)));
+    }
+}
+
+__attribute__((target("avx512f,popcnt")))
+static int compareCostsAVX512(const float* costs, const float* resources,
+                              int count, uint64_t* violated){
+    clearViolated(violated,count);
+    int numberOfViolations = 0;
+    int k = 0;
+    for(;k<count;k+=16){
+        __mmask16 mask = (count-k >= 16) ? 0xffff : (1u<<(count-k))-1;
+        uint64_t bits = _mm512_mask_cmp_ps_mask(mask,
+                                                _mm512_maskz_loadu_ps(mask,costs+k),
+                                                _mm512_maskz_loadu_ps(mask,resources+k),
+                                                _CMP_GT_OQ);
+        numberOfViolations += _mm_popcnt_u32((uint32_t)bits);
+        //16 bit groups never straddle a word, k is a multiple of 16
+        if(violated != NULL){
+            violated[k/64] |= bits<<(k%64);
+        }
+    }
+    return numberOfViolations;
+}
+
+#endif
+
+/* dispatch */
+
+static int compareCostsScalarAll(const float* costs, const float* resources,
+                                 int count, uint64_t* violated){
+    clearViolated(violated,count);
+    return compareCostsScalar(costs,resources,count,violated,0);
+}
+
+typedef void (*AddCostsKernel)(float*, const float*, int);
+typedef int (*CompareCostsKernel)(const float*, const float*, int, uint64_t*);
+
+/**
+ * Instruction set and kernels in use.
+ */
+typedef struct{
+    MMKPKernelSet kernelSet;
+    AddCostsKernel addCosts;
+    CompareCostsKernel compareCosts;
+}MMKPKernelTable;
+
+static bool isSupported(MMKPKernelSet kernelSet){
+#ifdef MMKP_KERNELS_X86
+    __builtin_cpu_init();
+    switch(kernelSet){
+        case KERNELS_AVX512:
+            return __builtin_cpu_supports("avx512f") &&
+                __builtin_cpu_supports("popcnt");
+        case KERNELS_AVX2:
+            return __builtin_cpu_supports("avx2") &&
+                __builtin_cpu_supports("popcnt");
+        default:
+            return true;
+    }
+#else
+    return (kernelSet == KERNELS_SCALAR);
+#endif
+}
+
+/**
+ * Fill param: kernels with the kernels of param: kernelSet. Return false,
+ * changing nothing, if it is not supported.
+ */
+static bool loadKernels(MMKPKernelTable& kernels, MMKPKernelSet kernelSet){
+    if(!isSupported(kernelSet)){
+        return false;
+    }
+    kernels.kernelSet = kernelSet;
+    switch(kernelSet){
+#ifdef MMKP_KERNELS_X86
+        case KERNELS_AVX512:
+            kernels.addCosts = addCostsAVX512;
+            kernels.compareCosts = compareCostsAVX512;
+            break;
+        case KERNELS_AVX2:
+            kernels.addCosts = addCostsAVX2;
+            kernels.compareCosts = compareCostsAVX2;
+            break;
+#endif
+        default:
+            kernels.addCosts = addCostsScalar;
+            kernels.compareCosts = compareCostsScalarAll;
+    }
+    return true;
+}
+
+/**
+ * Return the best supported kernels.
+ */
+static MMKPKernelTable selectKernels(){
+    MMKPKernelTable kernels;
+    if(!loadKernels(kernels,KERNELS_AVX512) &&
+       !loadKernels(kernels,KERNELS_AVX2)){
+        loadKernels(kernels,KERNELS_SCALAR);
+    }
+    return kernels;
+}
+
+/**
+ * Return the kernels in use, selected on first use, so they are ready for
+ * kernels called from static initializers of other files too.
+ */
+static MMKPKernelTable& getKernels(){
+    static MMKPKernelTable kernels = selectKernels();
+    return kernels;
+}
+
+bool setKernelSet(MMKPKernelSet kernelSet){
+    return loadKernels(getKernels(),kernelSet);
+}
+
+MMKPKernelSet getKernelSet(){
+    return getKernels().kernelSet;
+}
+
+void addCosts(float* sum, const float* costs, int count){
+    getKernels().addCosts(sum,costs,count);
+}
+
+int compareCosts(const float* costs, const float* resources, int count,
+                 uint64_t* violated){
+    return getKernels().compareCosts(costs,resources,count,violated);
+}
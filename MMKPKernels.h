@@ -0,0 +1,76 @@
+/*********************************************************
+ *
+ * File: MMKPKernels.h
+ * Author: Ken Zyma
+ *
+ * Vectorized cost kernels with a scalar fallback.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPKernels__
+#define ____MMKPKernels__
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * Instruction sets the kernels below can run on.
+ */
+enum MMKPKernelSet{
+    KERNELS_SCALAR = 0,
+    KERNELS_AVX2 = 1,
+    KERNELS_AVX512 = 2
+};
+
+/**
+ * Return the instruction set used by the kernels. The best one the
+ * processor supports is chosen the first time any kernel is used.
+ */
+MMKPKernelSet getKernelSet();
+
+/**
+ * Use param: kernelSet from here on (ex. to compare against the scalar
+ * kernels). Return false, changing nothing, if the processor or compiler
+ * does not support it. Not safe while kernels run on other threads.
+ */
+bool setKernelSet(MMKPKernelSet kernelSet);
+
+/**
+ * Add param: count costs to param: sum, sum[k] += costs[k]. Each sum is
+ * computed exactly as the scalar loop would, whatever the instruction set.
+ */
+void addCosts(float* sum, const float* costs, int count);
+
+/**
+ * Compare param: count costs against resources in one pass. Return the
+ * number of resources over-used (costs[k] > resources[k]), 0 if the costs
+ * are feasible. If param: violated is not NULL bit k of it (bit k%64 of
+ * word k/64) is set for every over-used resource and cleared otherwise,
+ * it must hold (count+63)/64 words.
+ */
+int compareCosts(const float* costs, const float* resources, int count,
+                 uint64_t* violated);
+
+#endif /* defined(____MMKPKernels__) */
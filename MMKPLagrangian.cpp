@@ -0,0 +1,160 @@
+/*********************************************************
+ *
+ * File: MMKPLagrangian.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPLagrangian
+ *
+ *********************************************************/
+
+#include "MMKPLagrangian.h"
+
+/**
+ * Return the dot product of two padded rows of length stride.
+ */
+static float dot(const float* a, const float* b, int stride){
+    float sum = 0;
+    for(int k=0;k<stride;k++){
+        sum += a[k]*b[k];
+    }
+    return sum;
+}
+
+/* MMKPLagrangian */
+
+MMKPLagrangian::MMKPLagrangian(MMKPDataSet dataSet):dataSet(dataSet){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    this->multipliers.assign(flatData.getStride(),0);
+    this->currentU.assign(flatData.getStride(),0);
+    this->subgradient.assign(flatData.getStride(),0);
+    this->choice.assign(flatData.getNumberOfClasses(),0);
+    this->bound = FLT_MAX;
+    MMKPLagrangian::evaluate(this->multipliers);
+}
+
+//accessors
+float MMKPLagrangian::getBound() const{
+    return this->bound;
+}
+
+const std::vector<float>& MMKPLagrangian::getMultipliers() const{
+    return this->multipliers;
+}
+
+float MMKPLagrangian::getReducedProfit(int item) const{
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    return flatData.getProfit(item) -
+        dot(this->multipliers.data(),flatData.getCosts(item),flatData.getStride());
+}
+
+const std::vector<int>& MMKPLagrangian::getChoice() const{
+    return this->choice;
+}
+
+const std::vector<float>& MMKPLagrangian::getSubgradient() const{
+    return this->subgradient;
+}
+
+std::vector<float> MMKPLagrangian::getStartingMultipliers() const{
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const float* resources = flatData.getResources();
+    std::vector<float> U(flatData.getStride(),0);
+    for(int i=0;i<flatData.getNumberOfClasses();i++){
+        const int end = flatData.getClassOffset(i+1);
+        const float classSize = flatData.getClassSize(i);
+        for(int item=flatData.getClassOffset(i);item<end;item++){
+            const float* costs = flatData.getCosts(item);
+            for(int k=0;k<flatData.getNumberOfResources();k++){
+                U[k] += costs[k]/classSize;
+            }
+        }
+    }
+    for(int k=0;k<flatData.getNumberOfResources();k++){
+        U[k] = std::max(0.0f,(U[k] - resources[k])/resources[k]);
+    }
+    return U;
+}
+
+//mutators
+float MMKPLagrangian::evaluate(const std::vector<float>& U){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int stride = flatData.getStride();
+    const float* resources = flatData.getResources();
+    assert(U.size() >= flatData.getNumberOfResources());
+    
+    //padding entries stay 0
+    for(int k=0;k<flatData.getNumberOfResources();k++){
+        this->currentU[k] = U[k];
+    }
+    const float* u = this->currentU.data();
+    
+    float L = dot(u,resources,stride);
+    for(int k=0;k<stride;k++){
+        this->subgradient[k] = -resources[k];
+    }
+    for(int i=0;i<flatData.getNumberOfClasses();i++){
+        const int begin = flatData.getClassOffset(i);
+        const int end = flatData.getClassOffset(i+1);
+        int bestItem = begin;
+        float bestReducedProfit = flatData.getProfit(begin) -
+            dot(u,flatData.getCosts(begin),stride);
+        for(int item=begin+1;item<end;item++){
+            float reducedProfit = flatData.getProfit(item) -
+                dot(u,flatData.getCosts(item),stride);
+            if(reducedProfit > bestReducedProfit){
+                bestReducedProfit = reducedProfit;
+                bestItem = item;
+            }
+        }
+        L += bestReducedProfit;
+        this->choice[i] = bestItem;
+        const float* costs = flatData.getCosts(bestItem);
+        for(int k=0;k<stride;k++){
+            this->subgradient[k] += costs[k];
+        }
+    }
+    
+    if(L < this->bound){
+        this->bound = L;
+        this->multipliers = this->currentU;
+    }
+    return L;
+}
+
+float MMKPLagrangian::solve(float lowerBound, int numberOfIterations){
+    const int numberOfResources = this->dataSet.getFlatData().getNumberOfResources();
+    
+    std::vector<float> U = MMKPLagrangian::getStartingMultipliers();
+    float L = MMKPLagrangian::evaluate(U);
+    float bestL = L;
+    float lambda = 1.0;
+    int stagnantIterations = 0;
+    for(int i=0;i<numberOfIterations;i++){
+        float den = 0;
+        for(int k=0;k<numberOfResources;k++){
+            den += this->subgradient[k]*this->subgradient[k];
+        }
+        //the choice uses every resource exactly, U is optimal
+        if(den == 0){break;}
+        
+        //step along the subgradient, L decreases as U moves toward
+        //the resources that are overused
+        float step = lambda*(L - lowerBound)/den;
+        for(int k=0;k<numberOfResources;k++){
+            U[k] = std::max(0.0f,U[k] + step*this->subgradient[k]);
+        }
+        L = MMKPLagrangian::evaluate(U);
+        
+        if(L < bestL){
+            bestL = L;
+            stagnantIterations = 0;
+        }else if(++stagnantIterations == 10){
+            lambda = lambda/2;
+            stagnantIterations = 0;
+        }
+    }
+    return this->bound;
+}
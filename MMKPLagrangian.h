@@ -0,0 +1,127 @@
+/*********************************************************
+ *
+ * File: MMKPLagrangian.h
+ * Author: Ken Zyma
+ *
+ * Lagrangian relaxation (dual bound) of an MMKP problem.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPLagrangian__
+#define ____MMKPLagrangian__
+
+#include <vector>
+#include <cstddef>
+#include <cfloat>
+#include <algorithm>
+#include <assert.h>
+
+#include "MMKPDataSet.h"
+#include "MMKPFlatData.h"
+
+/**
+ * Lagrangian relaxation of the resource constraints of an MMKP problem.
+ * For multipliers U >= 0
+ *
+ *     L(U) = sum over classes of max_j(p_ij - U*c_ij) + U*R
+ *
+ * is an upper bound on the optimal profit. solve minimizes L(U) by
+ * subgradient optimization and keeps the best (lowest) bound found along
+ * with its multipliers. Everything works on the flat arrays of the problem
+ * (class: MMKPFlatData), multipliers are padded to its stride so each
+ * reduced profit is a dot product over one padded cost row.
+ */
+class MMKPLagrangian{
+
+private:
+    MMKPDataSet dataSet;
+    std::vector<float> multipliers;     //best U found
+    float bound;                        //L(U) of multipliers
+    std::vector<int> choice;            //maximizing item of each class
+    std::vector<float> subgradient;     //sum of chosen costs - R
+    std::vector<float> currentU;        //scratch, padded
+public:
+    /**
+     * Construct for the problem param: dataSet, with U = 0 as the best
+     * multipliers so far.
+     */
+    MMKPLagrangian(MMKPDataSet dataSet);
+
+    //accessors
+    /**
+     * Return the best (lowest) bound found, L(U) of getMultipliers.
+     */
+    float getBound() const;
+
+    /**
+     * Return the best multipliers found, padded to the stride of the flat
+     * data (padding entries are 0).
+     */
+    const std::vector<float>& getMultipliers() const;
+
+    /**
+     * Return the reduced profit p - U*c of the item at flat index item,
+     * for the best multipliers found.
+     */
+    float getReducedProfit(int item) const;
+
+    /**
+     * Return the flat index of the item chosen in each class by the last
+     * call to evaluate.
+     */
+    const std::vector<int>& getChoice() const;
+
+    /**
+     * Return the subgradient (costs of getChoice minus resources) of the
+     * last call to evaluate, padded like the multipliers.
+     */
+    const std::vector<float>& getSubgradient() const;
+
+    /**
+     * Return multipliers to start the subgradient optimization from, the
+     * relative amount each resource is overused when every class takes
+     * its average item (0 if not overused).
+     */
+    std::vector<float> getStartingMultipliers() const;
+
+    //mutators
+    /**
+     * Return L(U) for multipliers param: U (at least one per resource) and
+     * set getChoice and getSubgradient. The best bound is updated if L(U)
+     * is lower.
+     */
+    float evaluate(const std::vector<float>& U);
+
+    /**
+     * Minimize L(U) by subgradient optimization, starting from
+     * getStartingMultipliers, for param: numberOfIterations iterations.
+     * Steps are sized by the gap to param: lowerBound, the profit of a
+     * known feasible solution (0 if there is none). The step factor is
+     * halved after 10 iterations without improvement. Return getBound.
+     */
+    float solve(float lowerBound, int numberOfIterations);
+};
+
+#endif /* defined(____MMKPLagrangian__) */
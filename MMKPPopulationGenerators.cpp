@@ -19,15 +19,11 @@ PopulationGenerator::~PopulationGenerator(){
 
 //test if solution is in population. Return false if it is, true otherwise.
 bool PopulationGenerator::notIncluded
-(MMKPSolution solution,std::vector<MMKPSolution> population){
+(const MMKPSolution& solution,const std::vector<MMKPSolution>& population){
     for(int i=0;i<population.size();i++){
         bool isSame = true;
-        for(int j=0;j<population[i].size();j++){
-            for(int k=0;k<population[i][j].size();k++){
-                if(solution[j].at(k) != population[i][j].at(k)){
-                    isSame = false;
-                }
-            }
+        for(int j=0;(j<population[i].size()) && isSame;j++){
+            isSame = (solution[j] == population[i][j]);
         }
         if(isSame == true)
             return false;
@@ -46,13 +42,13 @@ std::vector<MMKPSolution> GenerateRandomizedPopulation::operator()
 (MMKPDataSet dataSet,int populationSize){
     
     int solutionsFound = 0;
-    srand(this->seed);
+    MMKPRandom rng(this->seed);
     std::vector<MMKPSolution> population;
     
     while(solutionsFound < populationSize){
         MMKPSolution temp(dataSet.getSizeOfEachClass());
         for(int i=0;i<temp.size();i++){
-            int randomIndx = rand() % temp[i].size();
+            int randomIndx = rng.nextInt(temp[i].size());
             temp[i].at(randomIndx) = true;
         }
         dataSet.updateSolution(temp);
@@ -79,13 +75,13 @@ std::vector<MMKPSolution> GenerateRandomizedPopulationNoDups::operator()
 (MMKPDataSet dataSet,int populationSize){
     
     int solutionsFound = 0;
-    srand(this->seed);
+    MMKPRandom rng(this->seed);
     std::vector<MMKPSolution> population;
     
     while(solutionsFound < populationSize){
         MMKPSolution temp(dataSet.getSizeOfEachClass());
         for(int i=0;i<temp.size();i++){
-            int randomIndx = rand() % temp[i].size();
+            int randomIndx = rng.nextInt(temp[i].size());
             temp[i].at(randomIndx) = true;
         }
         dataSet.updateSolution(temp);
@@ -114,13 +110,13 @@ std::vector<MMKPSolution> GenerateRandomizedPopulationNoDups_Infeasible::operato
 (MMKPDataSet dataSet,int populationSize){
     
     int solutionsFound = 0;
-    srand(this->seed);
+    MMKPRandom rng(this->seed);
     std::vector<MMKPSolution> population;
     
     while(solutionsFound < populationSize){
         MMKPSolution temp(dataSet.getSizeOfEachClass());
         for(int i=0;i<temp.size();i++){
-            int randomIndx = rand() % temp[i].size();
+            int randomIndx = rng.nextInt(temp[i].size());
             temp[i].at(randomIndx) = true;
         }
         dataSet.updateSolution(temp);
@@ -148,18 +144,18 @@ GenerateRandomizedPopulationGreedyV1
 std::vector<MMKPSolution> GenerateRandomizedPopulationGreedyV1::operator()
 (MMKPDataSet dataSet,int populationSize){
     int solutionsFound = 0;
-    srand(this->seed);
+    MMKPRandom rng(this->seed);
     std::vector<MMKPSolution> population;
     
     while(solutionsFound < populationSize){
 
         MMKPSolution temp(dataSet.getSizeOfEachClass());
         //generate indices for profit/constraint ratio calculation
-        int numOfIndices = (rand() % dataSet.getNumberOfResources()) +1;
+        int numOfIndices = rng.nextInt(dataSet.getNumberOfResources()) +1;
         std::vector<int> constrIndices;
         
         for(int i=0;i<numOfIndices;){
-            int temp = (rand()%dataSet.getNumberOfResources());
+            int temp = rng.nextInt(dataSet.getNumberOfResources());
             bool isIn = false;
             for(int j=0;j<constrIndices.size();j++){
                 if(temp == constrIndices[j]){
@@ -174,11 +170,11 @@ std::vector<MMKPSolution> GenerateRandomizedPopulationGreedyV1::operator()
         //randomly select a  weighting for v/[Er%/n]
         std::vector<std::function<float(float p,float c)> > functors;
         functors.push_back([&](float p,float c){return p/c;});
-        functors.push_back([&](float p,float c){return ((p*(rand()%100))/c);});
+        functors.push_back([&](float p,float c){return ((p*rng.nextInt(100))/c);});
         functors.push_back([&](float p,float c){return p;});
         functors.push_back([&](float p,float c){return c;});
-        functors.push_back([&](float p,float c){return (rand()%100+1);});
-        int index = rand()%functors.size();
+        functors.push_back([&](float p,float c){return (rng.nextInt(100)+1);});
+        int index = rng.nextInt(functors.size());
         std::function<float(float p,float c)> surrFunction = functors[index];
     
         //run greedy
@@ -211,3 +207,127 @@ std::vector<MMKPSolution> GenerateRandomizedPopulationGreedyV1::operator()
                
                
                
+
+/* GENERATE CONSTRUCTIVE POPULATION */
+
+/**
+ * Hash of the item chosen in each class, for the set of solutions found.
+ */
+struct ChoiceHash{
+    std::size_t operator()(const std::vector<int>& choice) const{
+        uint64_t hash = 14695981039346656037ULL;    //FNV-1a
+        for(std::size_t i=0;i<choice.size();i++){
+            hash = (hash ^ (uint32_t)choice[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
+GenerateRandomizedPopulationConstructive::
+GenerateRandomizedPopulationConstructive()
+:seed(time(NULL)){}
+
+GenerateRandomizedPopulationConstructive::
+GenerateRandomizedPopulationConstructive
+(unsigned int seed):seed(seed){}
+
+std::vector<MMKPSolution> GenerateRandomizedPopulationConstructive::operator()
+(MMKPDataSet dataSet,int populationSize){
+    
+    const MMKPFlatData& flatData = dataSet.getFlatData();
+    const int numberOfClasses = flatData.getNumberOfClasses();
+    const int numberOfResources = flatData.getNumberOfResources();
+    const float* resources = flatData.getResources();
+    const int maxAttempts = 10*populationSize;
+    MMKPRandom rng(this->seed);
+    std::vector<MMKPSolution> population;
+    std::unordered_set<std::vector<int>,ChoiceHash> found;
+    
+    //costs of the lightest item (lowest Er%/n) of each class
+    std::vector<float> minCosts(numberOfClasses*numberOfResources);
+    for(int i=0;i<numberOfClasses;i++){
+        const float* costs = flatData.getCosts(flatData.getItemsByUse(i)[0]);
+        std::copy(costs,costs+numberOfResources,&minCosts[i*numberOfResources]);
+    }
+    
+    std::vector<int> order(numberOfClasses);
+    std::vector<int> choice(numberOfClasses);
+    std::vector<float> room(numberOfResources);
+    for(int attempts=0;population.size()<populationSize;attempts++){
+        for(int i=0;i<numberOfClasses;i++){
+            order[i] = i;
+        }
+        std::shuffle(order.begin(),order.end(),rng);
+        
+        //room = resources - lightest of every class not yet chosen
+        for(int k=0;k<numberOfResources;k++){
+            room[k] = resources[k];
+        }
+        for(int i=0;i<numberOfClasses;i++){
+            for(int k=0;k<numberOfResources;k++){
+                room[k] -= minCosts[i*numberOfResources+k];
+            }
+        }
+        
+        for(int c=0;c<numberOfClasses;c++){
+            const int i = order[c];
+            for(int k=0;k<numberOfResources;k++){
+                room[k] += minCosts[i*numberOfResources+k];
+            }
+            
+            //draw uniformly from the items that fit (reservoir sampling)
+            int numberFitting = 0;
+            int chosen = -1;
+            int leastOver = flatData.getClassOffset(i);
+            float leastOverVal = FLT_MAX;
+            for(int item=flatData.getClassOffset(i);
+                item<flatData.getClassOffset(i+1);item++){
+                const float* costs = flatData.getCosts(item);
+                bool fits = true;
+                float over = 0;
+                for(int k=0;k<numberOfResources;k++){
+                    if(costs[k] > room[k]){
+                        //overshoot relative to the resource, if it has any
+                        fits = false;
+                        float scale = (resources[k] > 0) ? resources[k] : 1;
+                        over = std::max(over,(costs[k]-room[k])/scale);
+                    }
+                }
+                if(fits){
+                    numberFitting++;
+                    if(rng.nextInt(numberFitting) == 0){
+                        chosen = item;
+                    }
+                }else if(over < leastOverVal){
+                    leastOver = item;
+                    leastOverVal = over;
+                }
+            }
+            if(chosen < 0){
+                chosen = leastOver;
+            }
+            
+            const float* costs = flatData.getCosts(chosen);
+            for(int k=0;k<numberOfResources;k++){
+                room[k] -= costs[k];
+            }
+            choice[i] = chosen - flatData.getClassOffset(i);
+        }
+        
+        MMKPSolution temp(dataSet.getSizeOfEachClass());
+        for(int i=0;i<numberOfClasses;i++){
+            temp[i].at(choice[i]) = true;
+        }
+        dataSet.updateSolution(temp);
+        
+        //past the attempt limits accept repeated, then infeasible solutions
+        bool isNew = found.insert(choice).second;
+        if((isNew || (attempts >= maxAttempts)) &&
+           (dataSet.isFeasible(temp) || (attempts >= 2*maxAttempts))){
+            population.push_back(temp);
+        }
+    }
+    
+    assert(population.size() == populationSize);
+    return population;
+}
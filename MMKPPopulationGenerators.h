@@ -37,16 +37,20 @@
 #include <vector>
 #include <time.h>
 #include <math.h>
+#include <cfloat>
+#include <algorithm>
+#include <unordered_set>
 
 #include "MMKPSolution.h"
 #include "MMKPDataSet.h"
+#include "MMKPRandom.h"
 
 class PopulationGenerator{
 public:
     virtual std::vector<MMKPSolution> operator()
     (MMKPDataSet dataSet,int populationSize) = 0;
     bool notIncluded
-    (MMKPSolution solution,std::vector<MMKPSolution> population);
+    (const MMKPSolution& solution,const std::vector<MMKPSolution>& population);
     virtual ~PopulationGenerator();
 };
 
@@ -161,4 +165,38 @@ public:
 
 };
 
+/**
+ * Generate a feasible, randomized population without rejection sampling.
+ * Each solution is built one class at a time, in a random order. A class
+ * takes an item drawn uniformly from those that fit the remaining capacity
+ * while leaving room for the lightest item (lowest Er%/n) of every class
+ * still to come, so every solution is feasible if the one taking all
+ * lightest items is. If no item fits, the class takes the one that
+ * overshoots the least, relative to each resource. Repeated solutions are
+ * found with a hash set of the chosen items. Building a solution is linear
+ * in the number of items, and the number of attempts is bounded: after 10
+ * attempts per solution asked for repeated solutions are accepted, after
+ * 20 infeasible ones too, so the generator always ends.
+ */
+class GenerateRandomizedPopulationConstructive:public PopulationGenerator{
+private:
+    unsigned int seed;
+public:
+    /**
+     * Constuct function object GenerateRandomizedPopulationConstructive.
+     */
+    GenerateRandomizedPopulationConstructive();
+    
+    /**
+     * Construct function object GenerateRandomizedPopulationConstructive
+     * with a seed for a predicable population.
+     */
+    GenerateRandomizedPopulationConstructive(unsigned int seed);
+    
+    /**
+     * Run generator and return a vector of solutions (MMKPSolution).
+     */
+    std::vector<MMKPSolution> operator()(MMKPDataSet dataSet,int populationSize);
+};
+
 #endif /* defined(____MMKPPopulationGenerators__) */
@@ -0,0 +1,71 @@
+/*********************************************************
+ *
+ * File: MMKPRandom.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPRandom
+ *
+ *********************************************************/
+
+#include "MMKPRandom.h"
+
+#include <random>
+
+/* MMKPRandom */
+
+MMKPRandom::MMKPRandom(){
+    MMKPRandom::seed(1234);
+}
+
+MMKPRandom::MMKPRandom(uint64_t seed){
+    MMKPRandom::seed(seed);
+}
+
+void MMKPRandom::seed(uint64_t seed){
+    //splitmix64
+    for(int i=0;i<4;i++){
+        seed += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        this->state[i] = z ^ (z >> 31);
+    }
+}
+
+void MMKPRandom::jump(){
+    static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t s0 = 0;
+    uint64_t s1 = 0;
+    uint64_t s2 = 0;
+    uint64_t s3 = 0;
+    for(int i=0;i<4;i++){
+        for(int b=0;b<64;b++){
+            if(JUMP[i] & ((uint64_t)1 << b)){
+                s0 ^= this->state[0];
+                s1 ^= this->state[1];
+                s2 ^= this->state[2];
+                s3 ^= this->state[3];
+            }
+            operator()();
+        }
+    }
+    this->state[0] = s0;
+    this->state[1] = s1;
+    this->state[2] = s2;
+    this->state[3] = s3;
+}
+
+MMKPRandom MMKPRandom::split(){
+    MMKPRandom stream = *this;
+    MMKPRandom::jump();
+    return stream;
+}
+
+uint64_t MMKPRandom::randomSeed(){
+    std::random_device rd;
+    return ((uint64_t)rd() << 32) ^ rd();
+}
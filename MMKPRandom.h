@@ -0,0 +1,128 @@
+/*********************************************************
+ *
+ * File: MMKPRandom.h
+ * Author: Ken Zyma
+ *
+ * Seedable, splittable pseudo random number generator.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPRandom__
+#define ____MMKPRandom__
+
+#include <stdint.h>
+#include <assert.h>
+
+/**
+ * Fast, explicitly seeded pseudo random number generator (xoshiro256**,
+ * Blackman and Vigna) used in place of rand() and std::mt19937. Each
+ * heuristic owns one and hands independent streams (see split) to local
+ * searches and worker threads, so a run is reproducible from its seed.
+ *
+ * Satisfies the UniformRandomBitGenerator requirements, so it may also be
+ * used with the <random> distributions.
+ */
+class MMKPRandom{
+    
+private:
+    uint64_t state[4];
+    
+    static uint64_t rotl(const uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
+public:
+    typedef uint64_t result_type;
+    
+    static constexpr result_type min(){return 0;}
+    static constexpr result_type max(){return UINT64_MAX;}
+    
+    /**
+     * Construct MMKPRandom with a fixed default seed.
+     */
+    MMKPRandom();
+    
+    /**
+     * Construct MMKPRandom seeded with param: seed.
+     */
+    explicit MMKPRandom(uint64_t seed);
+    
+    /**
+     * Reset the generator to the stream given by param: seed. The state is
+     * expanded from the seed with splitmix64, so nearby seeds give
+     * unrelated streams.
+     */
+    void seed(uint64_t seed);
+    
+    /**
+     * Return next 64 random bits.
+     */
+    result_type operator()(){
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+    
+    /**
+     * Return random integer in [0, n), n > 0.
+     */
+    int nextInt(int n){
+        assert(n > 0);
+        return (int)(((operator()() >> 32) * (uint64_t)n) >> 32);
+    }
+    
+    /**
+     * Return random float in [0, 1).
+     */
+    float nextFloat(){
+        return (operator()() >> 40) * (1.0f / 16777216.0f);
+    }
+    
+    /**
+     * Advance the generator by 2^128 steps, equivalent to that many calls
+     * of operator().
+     */
+    void jump();
+    
+    /**
+     * Return a generator for an independent stream, the current one, and
+     * jump this generator past it. Streams returned by successive calls do
+     * not overlap for 2^128 draws.
+     */
+    MMKPRandom split();
+    
+    /**
+     * Return a seed drawn from std::random_device, for runs that are not
+     * meant to be repeated.
+     */
+    static uint64_t randomSeed();
+};
+
+#endif /* defined(____MMKPRandom__) */
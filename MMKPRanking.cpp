@@ -0,0 +1,100 @@
+/*********************************************************
+ *
+ * File: MMKPRanking.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPRanking
+ *
+ *********************************************************/
+
+#include "MMKPRanking.h"
+
+/* MMKPRanking */
+
+bool MMKPRanking::isBetter(const MMKPRankKey& a, const MMKPRankKey& b){
+    if(a.profit != b.profit){
+        return (a.profit > b.profit);
+    }
+    if(a.isFeasible != b.isFeasible){
+        return a.isFeasible;
+    }
+    return (a.index < b.index);
+}
+
+MMKPRankKey MMKPRanking::getKey(const MMKPSolution& solution,
+                                const MMKPDataSet& dataSet, int index){
+    MMKPRankKey key;
+    key.profit = solution.getProfit();
+    key.isFeasible = dataSet.isFeasible(solution);
+    key.index = index;
+    return key;
+}
+
+//mutators
+void MMKPRanking::resize(int size){
+    this->keys.resize(size);
+    this->order.resize(size);
+}
+
+void MMKPRanking::setKey(int index, float profit, bool isFeasible){
+    this->keys[index].profit = profit;
+    this->keys[index].isFeasible = isFeasible;
+    this->keys[index].index = index;
+}
+
+void MMKPRanking::setKeys(const std::vector<MMKPSolution>& population,
+                          const MMKPDataSet& dataSet){
+    MMKPRanking::resize(population.size());
+    for(std::size_t i=0;i<population.size();i++){
+        this->keys[i] = MMKPRanking::getKey(population[i],dataSet,i);
+    }
+}
+
+const std::vector<int>& MMKPRanking::sort(){
+    std::sort(this->keys.begin(),this->keys.end(),MMKPRanking::isBetter);
+    for(std::size_t i=0;i<this->keys.size();i++){
+        this->order[i] = this->keys[i].index;
+    }
+    return this->order;
+}
+
+const std::vector<int>& MMKPRanking::sortTop(int k){
+    k = std::max(0,std::min<int>(k,this->keys.size()));
+    std::partial_sort(this->keys.begin(),this->keys.begin()+k,this->keys.end(),
+                      MMKPRanking::isBetter);
+    for(std::size_t i=0;i<this->keys.size();i++){
+        this->order[i] = this->keys[i].index;
+    }
+    return this->order;
+}
+
+//accessors
+const std::vector<int>& MMKPRanking::getOrder() const{
+    return this->order;
+}
+
+int MMKPRanking::insertLast(std::vector<MMKPSolution>& population,
+                            const MMKPDataSet& dataSet){
+    const int last = population.size()-1;
+    if(last < 1){return last;}
+    MMKPRankKey key = MMKPRanking::getKey(population[last],dataSet,last);
+    
+    //first rank the new member beats, ties stay ahead of it
+    int low = 0;
+    int high = last;
+    while(low < high){
+        int middle = (low+high)/2;
+        if(MMKPRanking::isBetter(key,MMKPRanking::getKey(population[middle],
+                                                         dataSet,middle))){
+            high = middle;
+        }else{
+            low = middle+1;
+        }
+    }
+    std::rotate(population.begin()+low,population.begin()+last,
+                population.end());
+    return low;
+}
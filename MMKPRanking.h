@@ -0,0 +1,162 @@
+/*********************************************************
+ *
+ * File: MMKPRanking.h
+ * Author: Ken Zyma
+ *
+ * Index based ranking of MMKP populations.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPRanking__
+#define ____MMKPRanking__
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <assert.h>
+
+#include "MMKPSolution.h"
+#include "MMKPDataSet.h"
+
+/**
+ * Sort key of one member of a population. Members are ranked by profit,
+ * greatest first. Among equal profits a feasible member ranks before an
+ * infeasible one, and after that the lower index goes first, so every
+ * ranking is repeatable.
+ */
+typedef struct{
+    float profit;
+    bool isFeasible;
+    int index;
+}MMKPRankKey;
+
+/**
+ * Ranks a population by sorting small keys (class: MMKPRankKey) instead
+ * of the solutions themselves. The result is an order of indices, best
+ * first, which can be read as it is or applied to the population with
+ * permute, one swap per misplaced member. Buffers are kept between calls,
+ * so ranking a population of the same size again does not allocate.
+ */
+class MMKPRanking{
+
+private:
+    std::vector<MMKPRankKey> keys;
+    std::vector<int> order;             //index of the member at each rank
+    std::vector<bool> isPlaced;         //scratch for permute
+    
+    static bool isBetter(const MMKPRankKey& a, const MMKPRankKey& b);
+public:
+    /**
+     * Return a key for param: solution at index param: index of its
+     * population.
+     */
+    static MMKPRankKey getKey(const MMKPSolution& solution,
+                              const MMKPDataSet& dataSet, int index);
+    
+    //mutators
+    /**
+     * Set the number of members to rank, the keys must then be set by
+     * setKey.
+     */
+    void resize(int size);
+    
+    /**
+     * Set the key of the member at param: index.
+     */
+    void setKey(int index, float profit, bool isFeasible);
+    
+    /**
+     * Set a key for every member of param: population.
+     */
+    void setKeys(const std::vector<MMKPSolution>& population,
+                 const MMKPDataSet& dataSet);
+    
+    /**
+     * Rank all members and return the order, best first.
+     */
+    const std::vector<int>& sort();
+    
+    /**
+     * Rank only the best param: k members, return the order with those
+     * in its first k entries, best first. The rest of the order is the
+     * remaining members in no particular order.
+     */
+    const std::vector<int>& sortTop(int k);
+    
+    //accessors
+    /**
+     * Return the order of the last sort or sortTop.
+     */
+    const std::vector<int>& getOrder() const;
+    
+    /**
+     * Reorder param: size members to the order of the last sort, where
+     * param: swap(a,b) swaps the members at index a and b.
+     */
+    template<class Swap>
+    void permute(int size, Swap swap);
+    
+    /**
+     * Reorder param: population to the order of the last sort.
+     */
+    template<class T>
+    void permute(std::vector<T>& population);
+    
+    /**
+     * param: population is ranked, except for its last member, which is
+     * moved to its rank among the others. Takes a binary search and a
+     * rotation, and returns the new index of the member.
+     */
+    static int insertLast(std::vector<MMKPSolution>& population,
+                          const MMKPDataSet& dataSet);
+};
+
+template<class Swap>
+void MMKPRanking::permute(int size, Swap swap){
+    assert(size == (int)this->order.size());
+    this->isPlaced.assign(size,false);
+    
+    //follow each cycle of the order, the member at rank i is order[i]
+    for(int i=0;i<size;i++){
+        if(this->isPlaced[i]){continue;}
+        int j = i;
+        while(true){
+            this->isPlaced[j] = true;
+            int k = this->order[j];
+            if(k == i){break;}
+            swap(j,k);
+            j = k;
+        }
+    }
+}
+
+template<class T>
+void MMKPRanking::permute(std::vector<T>& population){
+    MMKPRanking::permute(population.size(),[&](int a, int b){
+        std::swap(population[a],population[b]);
+    });
+}
+
+#endif /* defined(____MMKPRanking__) */
@@ -0,0 +1,157 @@
+/*********************************************************
+ *
+ * File: MMKPReduction.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKPReduction
+ *
+ *********************************************************/
+
+#include "MMKPReduction.h"
+
+/* MMKPReduction */
+
+MMKPReduction::MMKPReduction(MMKPDataSet dataSet):original(dataSet){
+    const MMKPFlatData& flatData = this->original.getFlatData();
+    const int numberOfClasses = flatData.getNumberOfClasses();
+    const int numberOfResources = flatData.getNumberOfResources();
+    const float* resources = flatData.getResources();
+    
+    this->stats.numberOfItems = flatData.getNumberOfItems();
+    this->stats.numberOfDominated = 0;
+    this->stats.numberOfUnfit = 0;
+    this->stats.numberOfFixedClasses = 0;
+    
+    std::vector<char> isKept(flatData.getNumberOfItems(),1);
+    for(int i=0;i<flatData.getNumberOfItems();i++){
+        if(flatData.isDominated(i)){
+            isKept[i] = 0;
+            this->stats.numberOfDominated++;
+        }
+    }
+    
+    //cheapest kept item of each class for each resource, removing an
+    //unfit item may make others unfit, so repeat until nothing changes
+    std::vector<float> minCosts(numberOfClasses*numberOfResources);
+    std::vector<float> minCostSum(numberOfResources);
+    std::vector<int> unfit;
+    bool isChanged = true;
+    while(isChanged){
+        isChanged = false;
+        std::fill(minCostSum.begin(),minCostSum.end(),0);
+        for(int i=0;i<numberOfClasses;i++){
+            float* classMin = &minCosts[i*numberOfResources];
+            std::fill(classMin,classMin+numberOfResources,FLT_MAX);
+            for(int item=flatData.getClassOffset(i);
+                item<flatData.getClassOffset(i+1);item++){
+                if(!isKept[item]){continue;}
+                const float* costs = flatData.getCosts(item);
+                for(int k=0;k<numberOfResources;k++){
+                    classMin[k] = std::min(classMin[k],costs[k]);
+                }
+            }
+            for(int k=0;k<numberOfResources;k++){
+                minCostSum[k] += classMin[k];
+            }
+        }
+        
+        for(int i=0;i<numberOfClasses;i++){
+            const float* classMin = &minCosts[i*numberOfResources];
+            int numberKept = 0;
+            unfit.clear();
+            for(int item=flatData.getClassOffset(i);
+                item<flatData.getClassOffset(i+1);item++){
+                if(!isKept[item]){continue;}
+                numberKept++;
+                const float* costs = flatData.getCosts(item);
+                for(int k=0;k<numberOfResources;k++){
+                    if(minCostSum[k] - classMin[k] + costs[k] > resources[k]){
+                        unfit.push_back(item);
+                        break;
+                    }
+                }
+            }
+            if(unfit.size() == numberKept){continue;}
+            for(std::size_t u=0;u<unfit.size();u++){
+                isKept[unfit[u]] = 0;
+            }
+            this->stats.numberOfUnfit += unfit.size();
+            isChanged = isChanged || !unfit.empty();
+        }
+    }
+    
+    //build the reduced problem from the kept items
+    std::vector<int> numberOfItemsPerClass(numberOfClasses,0);
+    for(int i=0;i<numberOfClasses;i++){
+        for(int item=flatData.getClassOffset(i);
+            item<flatData.getClassOffset(i+1);item++){
+            if(isKept[item]){
+                numberOfItemsPerClass[i]++;
+                this->itemMap.push_back(item);
+            }
+        }
+        if(numberOfItemsPerClass[i] == 1){
+            this->stats.numberOfFixedClasses++;
+        }
+    }
+    MMKPFlatData reducedData(numberOfItemsPerClass,
+                             std::vector<float>(resources,
+                                                resources+numberOfResources));
+    std::vector<float> costs(numberOfResources);
+    for(int i=0;i<numberOfClasses;i++){
+        for(int j=0;j<numberOfItemsPerClass[i];j++){
+            const int item = this->itemMap[reducedData.getItemIndex(i,j)];
+            costs.assign(flatData.getCosts(item),
+                         flatData.getCosts(item)+numberOfResources);
+            reducedData.setItem(i,j,flatData.getProfit(item),costs);
+        }
+    }
+    reducedData.setAnalytics();
+    this->reduced = MMKPDataSet(reducedData);
+}
+
+//accessors
+const MMKPDataSet& MMKPReduction::getOriginalDataSet() const{
+    return this->original;
+}
+
+const MMKPDataSet& MMKPReduction::getReducedDataSet() const{
+    return this->reduced;
+}
+
+int MMKPReduction::getOriginalItem(int classI, int itemI) const{
+    const int item =
+        this->itemMap[this->reduced.getFlatData().getItemIndex(classI,itemI)];
+    return item - this->original.getFlatData().getClassOffset(classI);
+}
+
+const MMKPReductionStats& MMKPReduction::getStats() const{
+    return this->stats;
+}
+
+MMKPSolution MMKPReduction::expand(const MMKPSolution& solution) const{
+    assert(solution.size() == this->original.size());
+    
+    MMKPSolution expanded(this->original.getSizeOfEachClass());
+    for(int i=0;i<solution.size();i++){
+        for(int j=0;j<solution[i].size();j++){
+            if(solution[i][j]){
+                expanded[i][MMKPReduction::getOriginalItem(i,j)] = true;
+            }
+        }
+    }
+    this->original.updateSolution(expanded);
+    return expanded;
+}
+
+//non-member functions
+std::ostream& operator<<(std::ostream& os, const MMKPReductionStats& obj){
+    os<<"Reduced "<<obj.numberOfItems<<" items to "
+        <<(obj.numberOfItems-obj.numberOfDominated-obj.numberOfUnfit)
+        <<" ("<<obj.numberOfDominated<<" dominated, "<<obj.numberOfUnfit
+        <<" never fit), "<<obj.numberOfFixedClasses<<" classes fixed.";
+    return os;
+}
@@ -0,0 +1,114 @@
+/*********************************************************
+ *
+ * File: MMKPReduction.h
+ * Author: Ken Zyma
+ *
+ * Removes items that can not be part of an optimal solution.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKPReduction__
+#define ____MMKPReduction__
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cfloat>
+#include <algorithm>
+#include <assert.h>
+
+#include "MMKPDataSet.h"
+#include "MMKPFlatData.h"
+#include "MMKPSolution.h"
+
+/**
+ * Size of an instance before and after reduction (class: MMKPReduction).
+ */
+typedef struct{
+    int numberOfItems;          //before reduction
+    int numberOfDominated;      //removed, dominated within their class
+    int numberOfUnfit;          //removed, can never be part of a feasible sol
+    int numberOfFixedClasses;   //classes left with a single item
+}MMKPReductionStats;
+
+/**
+ * Reduces an MMKP problem to the items that can be part of an optimal
+ * solution. Dominated items (see MMKPFlatData::isDominated) are removed,
+ * as are items that exceed a resource even when every other class takes
+ * its cheapest item for that resource. Removing items raises the cheapest
+ * cost of their class, so the second rule is applied until nothing
+ * changes. A class never loses its last item, if every item of a class is
+ * unfit the problem has no feasible solution and the class is kept as is.
+ *
+ * Heuristics run on getReducedDataSet, expand maps their solutions back to
+ * the items of the original problem.
+ */
+class MMKPReduction{
+
+private:
+    MMKPDataSet original;
+    MMKPDataSet reduced;
+    std::vector<int> itemMap;   //flat index in reduced -> flat index in original
+    MMKPReductionStats stats;
+public:
+    /**
+     * Reduce the problem param: dataSet.
+     */
+    MMKPReduction(MMKPDataSet dataSet);
+
+    //accessors
+    /**
+     * Return the problem as given to the constructor.
+     */
+    const MMKPDataSet& getOriginalDataSet() const;
+
+    /**
+     * Return the reduced problem, classes keep their order and their
+     * remaining items keep their relative order.
+     */
+    const MMKPDataSet& getReducedDataSet() const;
+
+    /**
+     * Return the index (within its class) of item param: itemI of class
+     * param: classI of the reduced problem in the original problem.
+     */
+    int getOriginalItem(int classI, int itemI) const;
+
+    /**
+     * Return the number of items removed and classes fixed.
+     */
+    const MMKPReductionStats& getStats() const;
+
+    /**
+     * Return param: solution of the reduced problem as a solution of the
+     * original problem, with profit and costs updated.
+     */
+    MMKPSolution expand(const MMKPSolution& solution) const;
+};
+
+//non-member functions
+std::ostream& operator<<(std::ostream& os, const MMKPReductionStats& obj);
+
+#endif /* defined(____MMKPReduction__) */
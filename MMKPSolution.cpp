@@ -14,9 +14,9 @@
 
 /* MMKPSolution */
 
-MMKPSolution::MMKPSolution():profitSummation(0){}
+MMKPSolution::MMKPSolution():profitSummation(0),cached(0){}
 
-MMKPSolution::MMKPSolution(std::vector<int> numberOfItemsPerClass){
+MMKPSolution::MMKPSolution(std::vector<int> numberOfItemsPerClass):cached(0){
     for(std::size_t i=0;i<numberOfItemsPerClass.size();i++){
         std::vector<bool> temp(numberOfItemsPerClass[i],false);
         this->solution.push_back(temp);
@@ -25,7 +25,7 @@ MMKPSolution::MMKPSolution(std::vector<int> numberOfItemsPerClass){
 }
 
 MMKPSolution::MMKPSolution(std::vector<int> numberOfItemsPerClass,
-             int numberOfConstraints){
+             int numberOfConstraints):cached(0){
     for(std::size_t i=0;i<numberOfItemsPerClass.size();i++){
         std::vector<bool> temp(numberOfItemsPerClass[i],false);
         this->solution.push_back(temp);
@@ -37,9 +37,15 @@ MMKPSolution::MMKPSolution(std::vector<int> numberOfItemsPerClass,
 //operator overloading
 std::vector<bool>& MMKPSolution::operator[](int index){
     assert(index<this->solution.size());
+    this->cached &= ~CACHED_MULTI_CHOICE;
     return this->solution.at(index);
 }
 
+const std::vector<bool>& MMKPSolution::operator[](int index) const{
+    assert(index<this->solution.size());
+    return this->solution[index];
+}
+
 bool MMKPSolution::operator==(MMKPSolution &other) const{
     for(int i=0;i<this->solution.size();i++){
         for(int j=0;j<this->solution[i].size();j++){
@@ -52,32 +58,68 @@ bool MMKPSolution::operator==(MMKPSolution &other) const{
 }
 
 //accessors
-int MMKPSolution::size(){
+int MMKPSolution::size() const{
     return this->solution.size();
 }
 
-float MMKPSolution::getProfit(){
+float MMKPSolution::getProfit() const{
     return this->profitSummation;
 }
 
-std::vector<float> MMKPSolution::getCostsSummation(){
+const std::vector<float>& MMKPSolution::getCostsSummation() const{
     return this->costsSummation;
 }
 
-float MMKPSolution::getCost(int index){
+float MMKPSolution::getCost(int index) const{
     return this->costsSummation.at(index);
 }
 
+bool MMKPSolution::getCachedMultiChoice(bool& isFeasible) const{
+    if(!(this->cached & CACHED_MULTI_CHOICE)){return false;}
+    isFeasible = this->multiChoiceFeasible;
+    return true;
+}
+
+bool MMKPSolution::getCachedViolations(int& count, uint64_t& violated) const{
+    if(!(this->cached & CACHED_MULTI_DIM)){return false;}
+    count = this->numberOfViolations;
+    violated = this->violatedResources;
+    return true;
+}
+
+void MMKPSolution::setCachedMultiChoice(bool isFeasible) const{
+    this->multiChoiceFeasible = isFeasible;
+    this->cached |= CACHED_MULTI_CHOICE;
+}
+
+void MMKPSolution::setCachedViolations(int count, uint64_t violated) const{
+    this->numberOfViolations = count;
+    this->violatedResources = violated;
+    this->cached |= CACHED_MULTI_DIM;
+}
+
 //mutators
-void MMKPSolution::setCosts(const std::vector<float> costsSummation){
+void MMKPSolution::setCosts(const std::vector<float>& costsSummation){
+    this->cached &= ~CACHED_MULTI_DIM;
     this->costsSummation = costsSummation;
 }
 
 void MMKPSolution::setCost(const std::size_t index, float costSummation){
     assert(index<this->costsSummation.size());
+    this->cached &= ~CACHED_MULTI_DIM;
     this->costsSummation.at(index) = costSummation;
 }
 
+void MMKPSolution::clearCosts(int numberOfConstraints){
+    this->cached &= ~CACHED_MULTI_DIM;
+    this->costsSummation.assign(numberOfConstraints,0);
+}
+
+void MMKPSolution::addCosts(const float* costs){
+    this->cached &= ~CACHED_MULTI_DIM;
+    ::addCosts(this->costsSummation.data(),costs,this->costsSummation.size());
+}
+
 void MMKPSolution::setProfit(const float profitSummation){
     this->profitSummation = profitSummation;
 }
@@ -38,6 +38,13 @@
 #include <iomanip>
 #include <functional>
 
+#include "MMKPKernels.h"
+
+/**
+ * Number of resources whose violations MMKPSolution can cache, one word.
+ */
+#define SOLUTION_CACHED_RESOURCES 64
+
 /**
  * Solution to MMKP problem consisting of class/item
  * selection, the summation of all classes' profit and
@@ -54,6 +61,13 @@ private:
     std::vector<std::vector<bool> > solution;
     float profitSummation;
     std::vector<float> costsSummation;
+    
+    //feasibility cache (see MMKPDataSet), a set CACHED_ flag means valid
+    enum{CACHED_MULTI_CHOICE = 1, CACHED_MULTI_DIM = 2};
+    mutable int cached;
+    mutable bool multiChoiceFeasible;
+    mutable int numberOfViolations;
+    mutable uint64_t violatedResources;
 public:
     
     /**
@@ -79,10 +93,14 @@ public:
      * Return a reference to a class of items. Usage is similar to
      * MMKPDataSet in class/item representation is similar to a
      * multi-dimensional array. ex: SolutionName[classNumber][itemNumber].
-     * Again, indexing begins at 0.
+     * Again, indexing begins at 0. The items may be changed through the
+     * reference, so the cached multiple-choice feasibility is cleared.
+     * Do not keep the reference past the next feasibility check.
      */
     std::vector<bool>& operator[](int index);
     
+    const std::vector<bool>& operator[](int index) const;
+    
     /**
      * Compare two MMKPSolutions, equality based on the values of
      * a solutions. If two solutions have the same bit's 'set', they
@@ -96,39 +114,77 @@ public:
     /**
      * Return number of class's in a MMKPSolution.
      */
-    int size();
+    int size() const;
     
     /**
      * Return profit of a MMKPSolution. *note* this is not updated
      * automatically when a solution changes and must be updated using
      * setProfit. This desision was for efficiency.
      */
-    float getProfit();
+    float getProfit() const;
     
     /**
      * Return costs of constraints for MMKPSolution. *note* this is not 
      * updated automatically when a solution changes and must be updated
      * using setCosts. This desision was for efficiency.
      */
-    std::vector<float> getCostsSummation();
+    const std::vector<float>& getCostsSummation() const;
     
     /**
      * Return cost summation for the cost contratint at corresponding index.
      */
-    float getCost(int index);
+    float getCost(int index) const;
+    
+    /**
+     * Return true if the multiple-choice feasibility of the solution is
+     * cached, and set param: isFeasible to it.
+     */
+    bool getCachedMultiChoice(bool& isFeasible) const;
+    
+    /**
+     * Return true if the resource violations of the solution are cached,
+     * and set param: count to their number and param: violated to a mask
+     * of the first SOLUTION_CACHED_RESOURCES over-used resources.
+     */
+    bool getCachedViolations(int& count, uint64_t& violated) const;
+    
+    /**
+     * Cache the multiple-choice feasibility of the solution. The cache is
+     * kept by MMKPDataSet, which is why a const solution may be updated.
+     * Solutions shared between threads must not be checked concurrently.
+     */
+    void setCachedMultiChoice(bool isFeasible) const;
+    
+    /**
+     * Cache the resource violations of the solution (see
+     * getCachedViolations).
+     */
+    void setCachedViolations(int count, uint64_t violated) const;
     
     
     //mutators
     /**
-     * Set cost constraints for a solution.
+     * Set cost constraints for a solution. Every cost mutator clears the
+     * cached resource violations.
      */
-    void setCosts(const std::vector<float> costsSummation);
+    void setCosts(const std::vector<float>& costsSummation);
     
     /**
      * Set a single cost constraint for solution given by param: index.
      */
     void setCost(const std::size_t index, float costSummation);
     
+    /**
+     * Set numberOfConstraints cost constraints, all 0.
+     */
+    void clearCosts(int numberOfConstraints);
+    
+    /**
+     * Add the costs of an item (one per cost constraint) to the cost
+     * constraints of the solution.
+     */
+    void addCosts(const float* costs);
+    
     /**
      * Set profit for a solution.
      */
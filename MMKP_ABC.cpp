@@ -36,6 +36,7 @@ MMKPSolution MMKP_ABC::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     this->currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
 
     //split population
     std::size_t const half_size = population.size() / 2;
@@ -84,7 +85,8 @@ MMKPSolution MMKP_ABC::run(std::vector<MMKPSolution> initialPopulation){
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= this->parameters.numberOfGenerations){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         currentGeneration++;
@@ -117,6 +119,7 @@ std::vector<MMKPSolution> MMKP_ABC::runOneGeneration
         
     employeedBees = MMKP_ABC::employeedBeePhase(employeedBees);
     onLookerBees = MMKP_ABC::onLookerBeePhase(onLookerBees,employeedBees);
+    currentFuncEvals += population.size();
     MMKP_ABC::scoutBeePhase(employeedBees);
     
     for(int i=0;i<empBees.size();i++){
@@ -134,27 +137,24 @@ std::vector<MMKPSolution> MMKP_ABC::runOneGeneration
 std::vector<MMKPBeeSolution> MMKP_ABC::employeedBeePhase
 (std::vector<MMKPBeeSolution> employeedBees){
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(0, 1);
     
     for(int i=0;i<employeedBees.size();i++){
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
         
         MMKPSolution newSolution = employeedBees[i].solution;
-        int tempI = rand() % employeedBees.size();
-        MMKPSolution compareSols = employeedBees[tempI].solution;
+        int tempI = this->rng.nextInt(employeedBees.size());
+        const MMKPSolution& compareSols = employeedBees[tempI].solution;
         
-        for(int j=0;j<newSolution.size();j++){
-            for(int k=0;k<newSolution[j].size();k++){
-                float p = dis(gen);
-                int o_ij = 0;
-                if(p < this->parameters.r){
-                    o_ij = 1;
-                }
-                newSolution[j][k] = newSolution[j][k] ^
-                    (o_ij&(newSolution[j][k] | compareSols[j][k]));
-            }
+        //x ^ (o & (x | c)), o is 1 with probability r
+        MMKPBitSolution x(newSolution);
+        MMKPBitSolution c(compareSols);
+        for(int w=0;w<x.getNumberOfWords();w++){
+            uint64_t o = nextBernoulliBits(this->rng,this->parameters.r,
+                                           x.getWordMask(w));
+            x.setWord(w,x.getWord(w) ^ (o & (x.getWord(w) | c.getWord(w))));
         }
+        x.toSolution(newSolution);
         
         MMKP_MetaHeuristic::makeFeasible(newSolution);
         if(newSolution.getProfit() > employeedBees[i].solution.getProfit()){
@@ -178,19 +178,18 @@ MMKP_ABC::onLookerBeePhase(std::vector<MMKPSolution> onLookerBees,
         totalObjVal += employeedBees[i].solution.getProfit();
         empBees.push_back(employeedBees[i].solution);
     }
-    MMKP_MetaHeuristic::quickSort(empBees,0,empBees.size()-1);
+    MMKP_MetaHeuristic::sortPopulation(empBees);
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(0, 1);
     
     for(int i=0;i<onLookerBees.size();i++){
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
         
         MMKPSolution newSolution = onLookerBees[i];
         //find index of solution to compare with, roulette style
         int tempI = 0;
         float accumulated = 0;
-        float c = dis(gen);
+        float c = dis(this->rng);
         for(int j=0;j<empBees.size();j++){
             accumulated += empBees[j].getProfit() / totalObjVal;
             if (accumulated > c){
@@ -202,7 +201,7 @@ MMKP_ABC::onLookerBeePhase(std::vector<MMKPSolution> onLookerBees,
         
         for(int j=0;j<newSolution.size();j++){
             for(int k=0;k<newSolution[j].size();k++){
-                float p = dis(gen);
+                float p = dis(this->rng);
                 int o_ij = 0;
                 if(p < this->parameters.r){
                     o_ij = 1;
@@ -232,7 +231,7 @@ void MMKP_ABC::scoutBeePhase(std::vector<MMKPBeeSolution>& employeedBees){
                     employeedBees[i].solution[j][k] = 0;
                 }
                 //mark one in every class..randomly
-                int classI = rand() % employeedBees[i].solution.size();
+                int classI = this->rng.nextInt(employeedBees[i].solution.size());
                 employeedBees[i].solution[j][classI] = true;
             }
             employeedBees[i].noImproveCount = 0;
@@ -15,7 +15,7 @@
 /*ACO_DataSetAdditions*/
 
 ACO_DataSetAdditions::ACO_DataSetAdditions(MMKPDataSet dataSet,float B,float e):
-denominators(dataSet.size()),B(B),isUpdated(false),Lstar(0),dataSet(dataSet){
+denominators(dataSet.size()),B(B),Lstar(0),dataSet(dataSet){
     
     //alloc constainers
     for(std::size_t i=0;i<dataSet.size();i++){
@@ -28,7 +28,7 @@ void ACO_DataSetAdditions::initParameters(){
     
     float INITIAL_PHERAMONE_VAL = 0.50;
     
-    //alloc heuristic information and pheramone values
+    //lower bound, the item of each class using the least of the resources
     MMKPSolution LB(dataSet.getSizeOfEachClass(),dataSet.getNumberOfResources());
     for(int i=0;i<LB.size();i++){
         int itemIndex = 0;
@@ -37,7 +37,7 @@ void ACO_DataSetAdditions::initParameters(){
             itemCR += dataSet[i][itemIndex].getCost(k) / dataSet.getResource(k);
         }
         for(int j=0;j<LB[i].size();j++){
-            int newCR = 0;
+            float newCR = 0;
             for(int k=0;k<dataSet.getNumberOfResources();k++){
                 newCR += dataSet[i][j].getCost(k) / dataSet.getResource(k);
             }
@@ -48,83 +48,20 @@ void ACO_DataSetAdditions::initParameters(){
         }
         LB[i][itemIndex] = true;
     }
+    dataSet.updateSolution(LB);
+    float lowerBound = dataSet.isFeasible(LB) ? LB.getProfit() : 0;
     
-    //a good LMV can be produced in 10*m iterations
-    //get u_0 vector
-    std::vector<float> u_0(dataSet.getNumberOfResources(),0);
-    for(int i=0;i<u_0.size();i++){
-        
-        float tempSum1 = 0;
-        for(int j=0;j<dataSet.size();j++){
-            float tempSum2 = 0;
-            for(int k=0;k<dataSet[j].size();k++){
-                tempSum2 += dataSet[j][k].getCost(i) / dataSet[j].size();
-            }
-            tempSum1 = tempSum2 - dataSet.getResource(i);
-        }
-        u_0[i] += tempSum1 / dataSet.getResource(i);
-        
-        if(u_0[i] < 0.0){
-            u_0[i] = 0.0;
-        }
-    }
-    
-    std::vector<float> best_U = u_0;
-    MMKPSolution best_LSol = ACO_DataSetAdditions::getLMV(u_0);
-    float best_L = best_LSol.getProfit();
-    
-    std::vector<float> past_u = best_U;
-    MMKPSolution past_sol = best_LSol;
-    int LSubCounter = 0;
-    for(int i=0;i<10*dataSet.getNumberOfResources();i++){
-        std::vector<float> curr_u(dataSet.getNumberOfResources(),0);
-        float lambda = 1.0;
-        
-        std::vector<float> SK(dataSet.getNumberOfResources());
-        float temp_sum = 0;
-        for(int k=0;k<dataSet.getNumberOfResources();k++){
-            SK[k] = getS_k(past_sol,k);
-            temp_sum += pow(SK[k],2);
-        }
-        float den = pow(sqrt(temp_sum),2);
-        
-        for(int k=0;k<dataSet.getNumberOfResources();k++){
-            float num =
-                (ACO_DataSetAdditions::getLMV(past_u)).getProfit()-LB.getProfit();
-            
-            curr_u[k] = (past_u[k] + lambda*(num/den)*(SK[k]));
-            if(curr_u[k] < 0){
-                curr_u[k] = 0;
-            }
-        }
-        MMKPSolution currLSol = ACO_DataSetAdditions::getLMV(curr_u);
-        float currLVM = currLSol.getProfit();
-        if(currLVM < best_L){
-            best_U = curr_u;
-            best_L = currLVM;
-            LSubCounter = 0;
-        }else{
-            LSubCounter++;
-        }
-        if(LSubCounter == 10){
-            lambda = lambda/2;
-        }
-        past_u = curr_u;
-        past_sol = currLSol;
-    }
-    
-    
-    float lambda = 1.0;
-    float U[dataSet.getNumberOfResources()];
+    //a good LMV can be produced in 10*m iterations, heuristic values
+    //are the lagrangian profits of its multipliers
+    MMKPLagrangian lagrangian(dataSet);
+    lagrangian.solve(lowerBound,10*dataSet.getNumberOfResources());
     
+    const MMKPFlatData& flatData = dataSet.getFlatData();
     for(int i=0;i<this->classList.size();i++){
         for(int j=0;j<this->classList[i].size();j++){
             this->classList[i][j].pheramone = INITIAL_PHERAMONE_VAL;
-            float c_ij = 0;
-            for(int k=0;k<dataSet[i][j].getNumberOfCosts();k++){
-                c_ij += (dataSet[i][j].getCost(k)*best_U[k]);
-            }
-            float lagrangian_ij = dataSet[i][j].getProfit() - c_ij;
+            float lagrangian_ij =
+                lagrangian.getReducedProfit(flatData.getItemIndex(i,j));
             if(lagrangian_ij < 0){
                 lagrangian_ij = 0.0005;  //NEEDS TO CHANGE
             }
@@ -132,106 +69,117 @@ void ACO_DataSetAdditions::initParameters(){
         }
     }
     
-    this->Lstar = best_L;
-}
-
-MMKPSolution ACO_DataSetAdditions::getLMV(std::vector<float> U){
-    
-    assert(dataSet.getNumberOfResources() == U.size());
-    
-    MMKPSolution sol(dataSet.getSizeOfEachClass(),dataSet.getNumberOfResources());
-    
-    float LU = 0;
-    for(int i=0;i<dataSet.size();i++){
-        float bestLagrangian = 0;
-        int bestLIndex = 0;
-        for(int j=0;j<dataSet[i].size();j++){
-            float tempC = 0;
-            for(int k=0;k<dataSet.getNumberOfResources();k++){
-                tempC += U[k]* dataSet[i][j].getCost(k);
-            }
-            float lagrangian = dataSet[i][j].getProfit() - tempC;
-            if(bestLagrangian < lagrangian){
-                bestLagrangian = lagrangian;
-                bestLIndex = j;
-            }
+    //heuristic values are fixed from here on. They are taken relative to
+    //the largest of the class, which leaves the probabilities as they are
+    //but keeps heuristic^B from overflowing
+    this->weights.resize(flatData.getNumberOfItems());
+    this->aliasProbability.resize(flatData.getNumberOfItems());
+    this->aliasIndex.resize(flatData.getNumberOfItems());
+    for(int i=0;i<this->classList.size();i++){
+        float maxHeuristic = 0;
+        for(int j=0;j<this->classList[i].size();j++){
+            maxHeuristic = std::max(maxHeuristic,this->classList[i][j].heuristic);
         }
-        LU += bestLagrangian;
-        sol[i][bestLIndex] = 1;
-    }
-    for(int k=0;k<dataSet.getNumberOfResources();k++){
-        LU += U[k]*dataSet.getResource(k);
-    }
-    sol.setProfit(LU); //hack to use the profit to carry our L(U) value
-    return sol;
-}
-
-float ACO_DataSetAdditions::getS_k(MMKPSolution sol,int r){
-    float temp = 0;
-    for(int i=0;i<sol.size();i++){
-        for(int j=0;j<sol[i].size();j++){
-            if(sol[i][j] == 1){
-                temp += dataSet[i][j].getCost(r);
-            }
+        for(int j=0;j<this->classList[i].size();j++){
+            this->weights[flatData.getItemIndex(i,j)] =
+                pow(this->classList[i][j].heuristic/maxHeuristic,this->B);
         }
+        ACO_DataSetAdditions::update(i);
     }
-    temp -= dataSet.getResource(r);
-    return temp;
     
+    this->Lstar = lagrangian.getBound();
 }
 
-std::vector<ACO_Additions>& ACO_DataSetAdditions::operator[](int index){
+bool ACO_DataSetAdditions::isInitialized() const{
+    return !this->weights.empty();
+}
+
+const std::vector<ACO_Additions>& ACO_DataSetAdditions::operator[]
+(int index) const{
     assert(index<this->classList.size());
-    this->isUpdated = false;
-    return this->classList.at(index);
+    return this->classList[index];
 }
 
-void ACO_DataSetAdditions::update(){
-    
-    for(int i=0;i<this->classList.size();i++){
-        float denomonator = 0.0;
-        for(int j=0;j<this->classList[i].size();j++){
-            denomonator += this->classList[i][j].pheramone
-            *pow(this->classList[i][j].heuristic,this->B);
+void ACO_DataSetAdditions::setPheramone(int classNum, int itemNum,
+                                        float pheramone){
+    assert(classNum<this->classList.size());
+    assert(itemNum<this->classList[classNum].size());
+    this->classList[classNum][itemNum].pheramone = pheramone;
+}
+
+void ACO_DataSetAdditions::update(int classNum){
+    const int offset = dataSet.getFlatData().getClassOffset(classNum);
+    const int classSize = this->classList[classNum].size();
+    
+    float denomonator = 0.0;
+    for(int j=0;j<classSize;j++){
+        denomonator += this->classList[classNum][j].pheramone
+            *this->weights[offset+j];
+    }
+    this->denominators[classNum] = denomonator;
+    
+    //Walker alias table (Vose), items above the mean probability fill
+    //up the items below it
+    float* probability = &this->aliasProbability[offset];
+    int* alias = &this->aliasIndex[offset];
+    this->small.clear();
+    this->large.clear();
+    for(int j=0;j<classSize;j++){
+        probability[j] = (denomonator > 0) ?
+            (this->classList[classNum][j].pheramone*this->weights[offset+j]
+             *classSize)/denomonator : 1;
+        alias[j] = j;
+        if(probability[j] < 1){
+            this->small.push_back(j);
+        }else{
+            this->large.push_back(j);
         }
-        this->denominators[i] = denomonator;
     }
-    
-    this->isUpdated = true;
+    while(!this->small.empty() && !this->large.empty()){
+        int less = this->small.back();
+        int more = this->large.back();
+        this->small.pop_back();
+        alias[less] = more;
+        probability[more] = (probability[more] + probability[less]) - 1;
+        if(probability[more] < 1){
+            this->large.pop_back();
+            this->small.push_back(more);
+        }
+    }
+    //left overs are 1 up to rounding
+    for(std::size_t j=0;j<this->small.size();j++){
+        probability[this->small[j]] = 1;
+    }
+    for(std::size_t j=0;j<this->large.size();j++){
+        probability[this->large[j]] = 1;
+    }
 }
 
-float ACO_DataSetAdditions::getProbability(int classNum, int itemNum){
+void ACO_DataSetAdditions::scale(int classNum, float factor){
+    this->denominators[classNum] *= factor;
+}
+
+float ACO_DataSetAdditions::getProbability(int classNum, int itemNum) const{
     assert(classNum<this->classList.size());
     assert(itemNum<this->classList[classNum].size());
     
-    if(!this->isUpdated){
-        ACO_DataSetAdditions::update();
-    }
-    
     /*
      * Equation (3): phara_ij*heur_ij^B / summation(phara_ij * heur_ij^B)
      */
     float denomonator = this->denominators[classNum];
     float numerator = this->classList[classNum][itemNum].pheramone
-        *pow(this->classList[classNum][itemNum].heuristic,this->B);
+        *this->weights[dataSet.getFlatData().getItemIndex(classNum,itemNum)];
     
     return numerator / denomonator;
 }
 
-int ACO_DataSetAdditions::returnItemIndex(int classNum){
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dif(0, 1);
-    
-    float r = dif(gen);
-    for(int j=0;j<dataSet[classNum].size();j++){
-        float temp = ACO_DataSetAdditions::getProbability(classNum,j);
-        if(r < temp){
-            return j;
-        }
-        r -= temp;
+int ACO_DataSetAdditions::returnItemIndex(int classNum, MMKPRandom& rng) const{
+    const int offset = dataSet.getFlatData().getClassOffset(classNum);
+    int j = rng.nextInt(this->classList[classNum].size());
+    if(rng.nextFloat() < this->aliasProbability[offset+j]){
+        return j;
     }
-    return -1;
+    return this->aliasIndex[offset+j];
 }
 
 int ACO_DataSetAdditions::size(){
@@ -247,7 +195,11 @@ float ACO_DataSetAdditions::getLStar(){
 //constructors
 MMKP_ACO::MMKP_ACO(MMKPDataSet dataSet, ACO_parameters parameters)
 :MMKP_MetaHeuristic(dataSet,parameters),parameters(parameters),
-solDesirability(dataSet,parameters.B,parameters.e){}
+solDesirability(dataSet,parameters.B,parameters.e){
+    if(this->parameters.numberOfThreads != 1){
+        this->pool.reset(new ThreadPool(this->parameters.numberOfThreads));
+    }
+}
 
 //overloaded operators
 MMKPSolution MMKP_ACO::operator()(std::vector<MMKPSolution> initialPopulation){
@@ -265,8 +217,9 @@ MMKPSolution MMKP_ACO::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     this->currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
-    MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
+    MMKP_MetaHeuristic::sortPopulation(population);
     for(int i=0;i<population.size();i++){
         if(dataSet.isFeasible(population[i])){
             bestSolution = population[i];
@@ -280,44 +233,38 @@ MMKPSolution MMKP_ACO::run(std::vector<MMKPSolution> initialPopulation){
     //main loop
     while(!terminationCriterion){
         
-        //reset population
-        for(int i=0;i<population.size();i++){
-            for(int j=0;j<population[i].size();j++){
-                for(int k=0;k<population[i][j].size();k++){
-                    population[i][j][k] = 0;
-                }
-            }
-        }
-        
         MMKP_ACO::constructSolutions(population);
         
-        //make every solution feasible
+        //record best solution from population, the ants are rebuilt next
+        //generation so there is no need to sort them
+        int best = -1;
         for(int i=0;i<population.size();i++){
-            MMKP_MetaHeuristic::makeFeasible(population[i]);
-            dataSet.updateSolution(population[i]);
-        }
-        
-        //record best solution from population
-        MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
-        for(int i=0;i<population.size();i++){
-            if(dataSet.isFeasible(population[i])){
-                bestSolutionOfGeneration.push_back(population[i]);
-                break;
+            if(((best < 0) ||
+                (population[i].getProfit() > population[best].getProfit())) &&
+               dataSet.isFeasible(population[i])){
+                best = i;
             }
         }
-        if(bestSolution.getProfit()
-           < bestSolutionOfGeneration[bestSolutionOfGeneration.size()-1].getProfit()){
-            bestSolution = bestSolutionOfGeneration[bestSolutionOfGeneration.size()-1];
-            this->convergenceIteration = currentGeneration;
+        if(best >= 0){
+            bestSolutionOfGeneration.push_back(population[best]);
+        }
+        //no feasible ant yet, leave the pheramone as it is
+        if(!bestSolutionOfGeneration.empty()){
+            if(bestSolution.getProfit()
+               < bestSolutionOfGeneration[bestSolutionOfGeneration.size()-1].getProfit()){
+                bestSolution = bestSolutionOfGeneration[bestSolutionOfGeneration.size()-1];
+                this->convergenceIteration = currentGeneration;
+            }
+            
+            updatePheramone(bestSolutionOfGeneration[(bestSolutionOfGeneration.size()-1)]);
         }
-        
-        updatePheramone(bestSolutionOfGeneration[(bestSolutionOfGeneration.size()-1)]);
         
         this->currentFuncEvals += population.size();
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= this->parameters.numberOfGenerations){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         currentGeneration++;
@@ -330,38 +277,68 @@ MMKPSolution MMKP_ACO::run(std::vector<MMKPSolution> initialPopulation){
 std::vector<MMKPSolution> MMKP_ACO::runOneGeneration
 (std::vector<MMKPSolution> population){
     
-    
-    MMKP_ACO::constructSolutions(population);
-    
-    //make every solution feasible
-    for(int i=0;i<population.size();i++){
-        MMKP_MetaHeuristic::makeFeasible(population[i]);
-        dataSet.updateSolution(population[i]);
+    if(!solDesirability.isInitialized()){
+        solDesirability.initParameters();
     }
+    MMKP_ACO::constructSolutions(population);
+    this->currentFuncEvals += population.size();
     
     return population;
 }
 
 void MMKP_ACO::constructSolutions(std::vector<MMKPSolution>& population){
     
-    for(int i=0;i<population.size();i++){
-        //get random permutation of class index's
-        int currentClassI[population[i].size()];
-        for(int j=0;j<population[i].size();j++){
-            currentClassI[j] = j;
+    std::vector<MMKPRandom> streams(population.size());
+    for(std::size_t i=0;i<population.size();i++){
+        streams[i] = this->rng.split();
+    }
+    
+    auto constructAnt = [&](int i){
+        if(!MMKP_MetaHeuristic::isBudgetExhausted()){
+            //each ant is built from scratch, as in run or on an island
+            for(int j=0;j<population[i].size();j++){
+                for(int k=0;k<population[i][j].size();k++){
+                    population[i][j][k] = 0;
+                }
+            }
+            
+            //get random permutation of class index's
+            std::vector<int> currentClassI(population[i].size());
+            for(int j=0;j<population[i].size();j++){
+                currentClassI[j] = j;
+            }
+            std::shuffle(currentClassI.begin(),currentClassI.end(),streams[i]);
+            
+            for(int j=0;j<population[i].size();j++){
+                int classChoosen = currentClassI[j];
+                int itemChoosen =
+                    solDesirability.returnItemIndex(classChoosen,streams[i]);
+                population[i][classChoosen][itemChoosen] = true;
+            }
         }
-        std::random_shuffle(currentClassI,currentClassI+population[i].size());
         
-        for(int j=0;j<population[i].size();j++){
-            int classChoosen = currentClassI[j];
-            int itemChoosen = solDesirability.returnItemIndex(classChoosen);
-            population[i][classChoosen][itemChoosen];
+        //make solution feasible
+        MMKP_MetaHeuristic::makeFeasible(population[i],
+                                this->parameters.multipleChoiceFeasibilityMod,
+                                this->parameters.multipleDimFeasibilityMod,
+                                streams[i]);
+        dataSet.updateSolution(population[i]);
+    };
+    
+    if(this->pool){
+        this->pool->parallelFor(population.size(),constructAnt);
+    }else{
+        for(std::size_t i=0;i<population.size();i++){
+            constructAnt(i);
         }
     }
 }
 
 void MMKP_ACO::updatePheramone(MMKPSolution bestSolution){
     
+    //the best solution meets the upper bound, it is optimal
+    if(solDesirability.getLStar() <= bestSolution.getProfit()){return;}
+    
     //find asymtotic t_max
     float tMax = 1/((1-this->parameters.p)
                     *(solDesirability.getLStar()-bestSolution.getProfit()));
@@ -369,6 +346,9 @@ void MMKP_ACO::updatePheramone(MMKPSolution bestSolution){
     float tMin = this->parameters.e * tMax;
     
     for(int i=0;i<this->solDesirability.size();i++){
+        //evaporation alone scales every item of a class alike, which
+        //leaves its probabilities as they are
+        bool isChanged = false;
         for(int j=0;j<this->solDesirability[i].size();j++){
             
             float rememberedPharamone =
@@ -390,7 +370,15 @@ void MMKP_ACO::updatePheramone(MMKPSolution bestSolution){
                 updatePheramoneVal = tMin;
             }
             
-            this->solDesirability[i][j].pheramone = updatePheramoneVal;
+            if(updatePheramoneVal != rememberedPharamone){
+                isChanged = true;
+            }
+            this->solDesirability.setPheramone(i,j,updatePheramoneVal);
+        }
+        if(isChanged){
+            this->solDesirability.update(i);
+        }else{
+            this->solDesirability.scale(i,this->parameters.p);
         }
     }
     
@@ -48,20 +48,26 @@
 #include "MMKP_MetaHeuristic.h"
 #include "MMKPSolution.h"
 #include "MMKPDataSet.h"
+#include "MMKPLagrangian.h"
+#include "ThreadPool.h"
 
 /**
- * Parameters for customizing the BBA algorithm.
+ * Parameters for customizing the ACO algorithm. numberOfThreads other
+ * than 1 builds the ants of a generation in parallel (see
+ * MMKP_ACO::constructSolutions), 0 uses every core.
  */
 class ACO_parameters:public MetaHeuristic_parameters{
 public:
     float B;    //B is the weighting of pheramone to heuristic
     float p;    //p and e in pheramone update rule
     float e;
+    int numberOfThreads;
     
     ACO_parameters(){
         this->B = 25.0;
         this->p = 0.98;
         this->e = 0.005;
+        this->numberOfThreads = 1;
     }
 };
 
@@ -70,27 +76,57 @@ typedef struct aco_additions{
     float heuristic;
 }ACO_Additions;
 
+/**
+ * Pheramone and heuristic values of every item. Items are chosen with a
+ * Walker alias table per class, so a choice takes O(1) no matter the
+ * number of items in the class. Tables are rebuilt by update, which only
+ * needs to be called for classes whose probabilities changed.
+ */
 class ACO_DataSetAdditions{
 private:
     std::vector<std::vector<ACO_Additions> > classList;
     std::vector<float> denominators;
+    std::vector<float> weights;             //heuristic^B of each item
+    std::vector<float> aliasProbability;    //alias table of each item
+    std::vector<int> aliasIndex;
+    std::vector<int> small;                 //scratch for building tables
+    std::vector<int> large;
     float B;        //pheramone/heuristic ratio
     float Lstar;    //tight upper bound
-    bool isUpdated;
-    void update();
-    MMKPSolution getLMV(std::vector<float> U);
-    float getS_k(MMKPSolution sol, int r);
     MMKPDataSet dataSet;
 public:
     ACO_DataSetAdditions(MMKPDataSet dataSet, float B,float e);
     
     void initParameters();
     
-    std::vector<ACO_Additions>& operator[](int index);
+    /**
+     * Return true once initParameters has been called.
+     */
+    bool isInitialized() const;
+    
+    const std::vector<ACO_Additions>& operator[](int index) const;
+    
+    /**
+     * Set pheramone of an item. Probabilities of the class are not
+     * changed until update is called for it.
+     */
+    void setPheramone(int classNum, int itemNum, float pheramone);
+    
+    /**
+     * Recompute the probabilities of class classNum and rebuild its alias
+     * table.
+     */
+    void update(int classNum);
+    
+    /**
+     * Recompute the probabilities of class classNum after every pheramone
+     * in it was multiplied by the same factor, which does not change them.
+     */
+    void scale(int classNum, float factor);
     
-    float getProbability(int classNum, int itemNum);
+    float getProbability(int classNum, int itemNum) const;
     
-    int returnItemIndex(int classNum);
+    int returnItemIndex(int classNum, MMKPRandom& rng) const;
     
     int size();
     
@@ -105,6 +141,7 @@ class MMKP_ACO:public MMKP_MetaHeuristic{
 private:
     ACO_parameters parameters;
     ACO_DataSetAdditions solDesirability;
+    std::shared_ptr<ThreadPool> pool;
 public:
     
     MMKP_ACO(MMKPDataSet dataSet, ACO_parameters parameters);
@@ -116,6 +153,13 @@ public:
     std::vector<MMKPSolution> runOneGeneration
     (std::vector<MMKPSolution> population);
     
+    /**
+     * Build an ant in every solution of param: population, make it feasible
+     * and update it. Ants only read the pheramone values, which are left
+     * as they are until updatePheramone, so they are built independently:
+     * each from its own stream split from rng up front, on the thread pool
+     * when there is one. The result is the same for any number of threads.
+     */
     void constructSolutions(std::vector<MMKPSolution>& population);
     
     void updatePheramone(MMKPSolution bestSol);
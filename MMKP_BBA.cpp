@@ -14,6 +14,31 @@
 
 /* MMKP_BBA */
 
+/**
+ * Velocity step of the bits of param: mask, equations 2, 7 and 8. Bit s
+ * of a bat moves with velocity vTemp = v + (s-b)*fTemp, b the bit of the
+ * best bat, and becomes 1 with probability 1/(1+exp(-vTemp)). s-b takes
+ * 3 values only, so 3 probabilities cover a whole word. Adds every vTemp
+ * to param: sumV.
+ */
+static uint64_t flyBits(uint64_t s, uint64_t b, uint64_t mask, float v,
+                        float fTemp, MMKPRandom& rng, float& sumV){
+    uint64_t selectors[3];
+    selectors[0] = ~s & b & mask;   //s-b = -1
+    selectors[2] = s & ~b & mask;   //s-b = 1
+    selectors[1] = mask & ~(selectors[0] | selectors[2]);
+    
+    uint32_t thresholds[3];
+    for(int d=0;d<3;d++){
+        float vTemp = v + (d-1)*fTemp;
+        thresholds[d] = getBernoulliThreshold(1/(1+(exp(-(vTemp)))));
+    }
+    sumV += __builtin_popcountll(mask)*v +
+        (__builtin_popcountll(selectors[2]) -
+         __builtin_popcountll(selectors[0]))*fTemp;
+    return nextBernoulliBits(rng,thresholds,selectors,3);
+}
+
 //constructors
 MMKP_BBA::MMKP_BBA(MMKPDataSet dataSet, BBA_parameters parameters)
 :MMKP_MetaHeuristic(dataSet,parameters),parameters(parameters){}
@@ -23,38 +48,16 @@ MMKPSolution MMKP_BBA::operator()(std::vector<MMKPSolution> initialPopulation){
     return MMKP_BBA::run(initialPopulation);
 }
 
-void MMKP_BBA::quickSort(std::vector<MMKPBatSolution>& input,int p, int r){
-    if ( p < r )
-    {
-        int j = partition(input, p, r);
-        MMKP_BBA::quickSort(input, p, j-1);
-        MMKP_BBA::quickSort(input, j+1, r);
+void MMKP_BBA::sortBats(std::vector<MMKPBatSolution>& population){
+    this->ranking.resize(population.size());
+    for(std::size_t i=0;i<population.size();i++){
+        this->ranking.setKey(i,population[i].solution.getProfit(),
+                             this->dataSet.isFeasible(population[i].solution));
     }
-}
-
-int MMKP_BBA::partition(std::vector<MMKPBatSolution>& input,int p, int r){
-    //partition will sort greatest->least
-    int pivot = input[r].solution.getProfit();
-    while ( p < r )
-    {
-        while ( input[p].solution.getProfit() > pivot )
-            p++;
-        
-        while ( input[r].solution.getProfit() < pivot )
-            r--;
-        
-        if ( input[p].solution.getProfit() == input[r].solution.getProfit() )
-            p++;
-        
-        else if (p < r )
-        {
-            MMKPSolution tmp = input[p].solution;
-            input[p].solution = input[r].solution;
-            input[r].solution = tmp;
-        }
-    }
-    
-    return r;
+    this->ranking.sort();
+    this->ranking.permute(population.size(),[&](int a, int b){
+        std::swap(population[a].solution,population[b].solution);
+    });
 }
 
 MMKPSolution MMKP_BBA::run(std::vector<MMKPSolution> initialPopulation){
@@ -72,8 +75,9 @@ MMKPSolution MMKP_BBA::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
-    MMKP_BBA::quickSort(population,0,(population.size()-1));
+    MMKP_BBA::sortBats(population);
     MMKPSolution bestSolution;
     for(int i=0;i<population.size();i++){
         if(this->dataSet.isFeasible(population[i].solution)){
@@ -89,7 +93,7 @@ MMKPSolution MMKP_BBA::run(std::vector<MMKPSolution> initialPopulation){
     while(!terminationCriterion){
         
         MMKP_BBA::globalSearch(population);
-        MMKP_BBA::quickSort(population,0,(population.size()-1));
+        MMKP_BBA::sortBats(population);
         
         for(int i=0;i<population.size();i++){
             if(this->dataSet.isFeasible(population[i].solution)){
@@ -104,7 +108,8 @@ MMKPSolution MMKP_BBA::run(std::vector<MMKPSolution> initialPopulation){
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= this->parameters.numberOfGenerations){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         this->currentGeneration++;
@@ -122,7 +127,7 @@ std::vector<MMKPSolution> MMKP_BBA::runOneGeneration
     for(int i=0;i<population.size();i++){
         tempPopulation[i].solution = population[i];
     }
-    MMKP_BBA::quickSort(tempPopulation,0,(population.size()-1));
+    MMKP_BBA::sortBats(tempPopulation);
     MMKP_BBA::initBatParemeters(tempPopulation);
     MMKP_BBA::globalSearch(tempPopulation);
     
@@ -136,8 +141,6 @@ std::vector<MMKPSolution> MMKP_BBA::runOneGeneration
 
 void MMKP_BBA::initBatParemeters(std::vector<MMKPBatSolution>& population){
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     
     for(int i=0;i<population.size();i++){
         std::uniform_real_distribution<> dif(0, 1);
@@ -148,8 +151,8 @@ void MMKP_BBA::initBatParemeters(std::vector<MMKPBatSolution>& population){
         float f1;
         float f2;
         do{
-            f1 = dif(gen);
-            f2 = dif(gen);
+            f1 = dif(this->rng);
+            f2 = dif(this->rng);
         }while(f1 == f2);
         
         if(f1 > f2){
@@ -161,66 +164,57 @@ void MMKP_BBA::initBatParemeters(std::vector<MMKPBatSolution>& population){
         }
         
         //init velocity
-        population[i].v = div(gen);
+        population[i].v = div(this->rng);
         
         //init rate of pulse
-        population[i].r = dif(gen);
-        population[i].r_0 =dif(gen);
+        population[i].r = dif(this->rng);
+        population[i].r_0 =dif(this->rng);
         
         //init loudness
-        population[i].a = dif(gen);
+        population[i].a = dif(this->rng);
     }
 }
 
 void MMKP_BBA::globalSearch(std::vector<MMKPBatSolution>& population){
     //already in sorted order in this implementation.
-    //MMKP_BBA::quickSort(population,0,(population.size()-1));
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    //MMKP_BBA::sortBats(population);
     std::uniform_real_distribution<> dib(0, 1);
     
     MMKPBatSolution bestBat = population[0];
     
-    ReactiveLocalSearch RLS(dataSet);
+    ReactiveLocalSearch RLS(dataSet,this->rng.split());
     bestBat.solution = RLS(bestBat.solution);
     this->currentFuncEvals += RLS.getFuncEvals();
     
     for(int i=0;i<population.size();i++){
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
         
         MMKPBatSolution currentBat = population[i];
         
         //equation 1
-        float B = dib(gen);
+        float B = dib(this->rng);
         float fTemp = currentBat.fmax + ((currentBat.fmax
                                           -currentBat.fmin)*B);
         
         //equation 2
         float averageV = 0.0;
         int averageVSize = 0;
-        for(int j=0;j<currentBat.solution.size();j++){
-            for(int k=0;k<currentBat.solution[j].size();k++){
-                this->currentFuncEvals++;
-                float vTemp = currentBat.v + ((currentBat.solution[j][k]
-                                               -bestBat.solution[j][k])*fTemp);
-                averageV += vTemp;
-                averageVSize++;
-                
-                //equation "3"--binary uses 7 and 8
-                float normalizedV = 1/(1+(exp(-(vTemp))));
-                float r = dib(gen);
-                
-                if(r <= normalizedV){
-                    currentBat.solution[j][k] = 1;
-                }else{
-                    currentBat.solution[j][k] = 0;
-                }
-            }
+        //equation "3"--binary uses 7 and 8, a word at a time
+        MMKPBitSolution bits(currentBat.solution);
+        MMKPBitSolution bestBits(bestBat.solution);
+        for(int w=0;w<bits.getNumberOfWords();w++){
+            bits.setWord(w,flyBits(bits.getWord(w),bestBits.getWord(w),
+                                   bits.getWordMask(w),currentBat.v,fTemp,
+                                   this->rng,averageV));
         }
+        bits.toSolution(currentBat.solution);
+        averageVSize = bits.size();
+        this->currentFuncEvals += bits.size();
         currentBat.v = (averageV/averageVSize);
         MMKP_MetaHeuristic::makeFeasible(currentBat.solution);
         
-        if(dib(gen) > currentBat.r){
-            int localSolutionIndex = rand() % 10;
+        if(dib(this->rng) > currentBat.r){
+            int localSolutionIndex = this->rng.nextInt(10);
             MMKPBatSolution bestBat = population[localSolutionIndex];
             MMKP_BBA::localSearch(bestBat,currentBat);
         }else{
@@ -240,11 +234,9 @@ void MMKP_BBA::competitiveUpdateSol
     bool solFeas = this->dataSet.isFeasible(sol.solution);
     bool newFeas = this->dataSet.isFeasible(newSol.solution);
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dib(0, 1);
     
-    if(dib(gen) < sol.a){
+    if(dib(this->rng) < sol.a){
         //if both feasible, choose best profit
         if(newFeas && solFeas){
             if((newSol.solution).getProfit() > (sol.solution).getProfit()){
@@ -268,18 +260,16 @@ void MMKP_BBA::competitiveUpdateSol
 void MMKP_BBA::localSearch(MMKPBatSolution& bestBat,MMKPBatSolution& solution){
         
     //already in sorted order in this implementation.
-    //MMKP_BBA::quickSort(population,0,(population.size()-1));
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    //MMKP_BBA::sortBats(population);
     std::uniform_real_distribution<> dib(0, 1);
-    float r_1 = dib(gen);
+    float r_1 = dib(this->rng);
     
     //find P1 and P2
-    int P1 = rand() % solution.solution.size();
-    int P2 = (rand() % (solution.solution.size()-P1)) + (P1);
+    int P1 = this->rng.nextInt(solution.solution.size());
+    int P2 = this->rng.nextInt(solution.solution.size()-P1) + (P1);
 
     //equation 1
-    float B = dib(gen);
+    float B = dib(this->rng);
     float fTemp = solution.fmax + ((solution.fmax
                                       -solution.fmin)*B);
     
@@ -287,24 +277,21 @@ void MMKP_BBA::localSearch(MMKPBatSolution& bestBat,MMKPBatSolution& solution){
     float averageV = 0.0;
     int averageVSize = 0;
     for(int j=P1;j<P2;j++){
-        for(int k=0;k<solution.solution[j].size();k++){
-            this->currentFuncEvals++;
-            float vTemp = solution.v + ((solution.solution[j][k]
-                                           -bestBat.solution[j][k])*fTemp);
-            averageV += vTemp;
-            averageVSize++;
-            
-            //equation "3"--binary uses 7 and 8
-            float normalizedV = 1/(1+(exp(-(vTemp))));
-            float r = dib(gen);
-            
-            if(r <= normalizedV){
-                solution.solution[j][k] = 1;
-            }else{
-                solution.solution[j][k] = 0;
-            }
-            
+        //equation "3"--binary uses 7 and 8, up to a word at a time
+        std::vector<bool>& bits = solution.solution[j];
+        const int classSize = bits.size();
+        for(int k=0;k<classSize;k+=64){
+            const int count = std::min(classSize-k,64);
+            const uint64_t mask = (count == 64) ? ~(uint64_t)0 :
+                (((uint64_t)1<<count)-1);
+            uint64_t word = flyBits(MMKPBitSolution::packBits(bits,k,count),
+                                    MMKPBitSolution::packBits(bestBat.solution[j],
+                                                              k,count),
+                                    mask,solution.v,fTemp,this->rng,averageV);
+            MMKPBitSolution::unpackBits(word,bits,k,count);
         }
+        averageVSize += classSize;
+        this->currentFuncEvals += classSize;
         solution.v = (averageV/averageVSize);
         MMKP_MetaHeuristic::makeFeasible(solution.solution);
     }
@@ -312,20 +299,18 @@ void MMKP_BBA::localSearch(MMKPBatSolution& bestBat,MMKPBatSolution& solution){
 
 void MMKP_BBA::randomSearch(MMKPBatSolution& sol){
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dib(0, 1);
     
     //generate new random solution
     MMKPSolution newSol = sol.solution;
     for(int i=0;i<newSol.size();i++){
-        int randomIndx = rand() % newSol[i].size();
+        int randomIndx = this->rng.nextInt(newSol[i].size());
         newSol[i].at(randomIndx) = true;
     }
     MMKP_MetaHeuristic::makeFeasible(newSol);
     
     //update sol
-    float r_1 = dib(gen);
+    float r_1 = dib(this->rng);
     if(r_1 < sol.a){
         bool updateAandR = false;
         float rateOfChange = .85;
@@ -360,14 +345,12 @@ void MMKP_BBA::randomSearch(MMKPBatSolution& sol){
 }
 
 void MMKP_BBA::Mutate(MMKPBatSolution& sol){
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dif(0, 1);
     
     for(int i=0;i<sol.solution.size();i++){
         for(int j=0;j<sol.solution[i].size();j++){
             this->currentFuncEvals++;
-            float r = dif(gen);
+            float r = dif(this->rng);
             if(r < .05){
                 if(sol.solution[i][j] == 0){
                     sol.solution[i][j] = 1;
@@ -27,6 +27,7 @@
 
 #include "MMKP_MetaHeuristic.h"
 #include "MMKPSolution.h"
+#include "MMKPBitSolution.h"
 #include "MMKPDataSet.h"
 #include "MMKP_LocalSearch.h"
 
@@ -56,15 +57,19 @@ typedef struct{
 class MMKP_BBA:public MMKP_MetaHeuristic{
 private:
     BBA_parameters parameters;
+    MMKPRanking ranking;
 public:
 
     MMKP_BBA(MMKPDataSet dataSet, BBA_parameters parameters);
     
     MMKPSolution operator()(std::vector<MMKPSolution> initialPopulation);
     
-    void quickSort(std::vector<MMKPBatSolution>& input,int p, int r);
-    
-    int partition(std::vector<MMKPBatSolution>& input,int p, int r);
+    /**
+     * Sort the solutions of param: population by profit, greatest first.
+     * Only solutions move, each bat keeps its own velocity, pulse rate and
+     * loudness.
+     */
+    void sortBats(std::vector<MMKPBatSolution>& population);
     
     MMKPSolution run(std::vector<MMKPSolution> initialPopulation);
     
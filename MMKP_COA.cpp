@@ -35,6 +35,7 @@ MMKPSolution MMKP_COA::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     this->currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
     MMKPSolution bestSolution;
     for(int i=0;i<population.size();i++){
@@ -65,7 +66,8 @@ MMKPSolution MMKP_COA::run(std::vector<MMKPSolution> initialPopulation){
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= this->parameters.numberOfGenerations){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         
@@ -80,6 +82,7 @@ std::vector<MMKPSolution> MMKP_COA::runOneGeneration
     
     MMKP_COA::horizontalCrossover(population);
     MMKP_COA::verticalCrossover(population);
+    this->currentFuncEvals += population.size()*2;
     return population;
     
 }
@@ -93,50 +96,38 @@ void MMKP_COA::horizontalCrossover(std::vector<MMKPSolution>& population){
     for(int i=0;i<M;i++){
         temp[i] = i;
     }
-    std::random_shuffle(temp,temp+M);
+    std::shuffle(temp,temp+M,this->rng);
     
     for(int i=0;i<(M/2);i++){
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
         std::uniform_real_distribution<> dis(0, 1);
-        float p = dis(gen);
+        float p = dis(this->rng);
         
         if (p<this->parameters.horizCrossProb){
             float no1 = temp[2*i];
             float no2 = temp[2*i+1];
-            int D = population[no1].size();
             
             //our two solutions
             MMKPSolution Xi = population[no1];
             MMKPSolution Xj = population[no2];
             
-            for(int j=0;j<D;j++){
-                for(int k=0;k<population[no1][j].size();k++){
-                    //generate uniform number
-                    std::uniform_int_distribution<> rs(0, 1);
-                    std::uniform_int_distribution<> cs(-1, 1);
-                    int r1 = rs(gen);
-                    int r2 = rs(gen);
-                    int c1 = cs(gen);
-                    int c2 = cs(gen);
-                    
-                    //functions to create new solutions
-                    int tempXi =
-                    r1*Xi[j][k]+(1-r1)*Xj[j][k]+c1*(Xi[j][k]-Xj[j][k]);
-                    int tempXj =
-                    r2*Xj[j][k]+(1-r2)*Xi[j][k]+c2*(Xi[j][k]-Xj[j][k]);
-                    if(tempXi<1){
-                        Xi[j][k] = 0;
-                    }else{
-                        Xi[j][k] = 1;
-                    }
-                    if(tempXj<1){
-                        Xj[j][k] = 0;
-                    }else{
-                        Xj[j][k] = 1;
-                    }
-                }
+            //Xi = r1*Xi+(1-r1)*Xj+c1*(Xi-Xj) >= 1 (and likewise Xj) keeps
+            //the bits the two agree on, where they differ r and c
+            //(uniform in {0,1} and {-1,0,1}) make it 1 with probability
+            //1/2, so each new bit there is one random bit
+            MMKPBitSolution bitsI(Xi);
+            MMKPBitSolution bitsJ(Xj);
+            for(int w=0;w<bitsI.getNumberOfWords();w++){
+                const uint64_t same = bitsI.getWord(w) & bitsJ.getWord(w);
+                const uint64_t differ = bitsI.getWord(w) ^ bitsJ.getWord(w);
+                const uint64_t r1 = this->rng();
+                const uint64_t r2 = this->rng();
+                bitsI.setWord(w,same | (differ & r1));
+                bitsJ.setWord(w,same | (differ & r2));
             }
+            bitsI.toSolution(Xi);
+            bitsJ.toSolution(Xj);
+            
             //regain feasibility in new solutions
             MMKP_MetaHeuristic::makeFeasible(Xi);
             MMKP_MetaHeuristic::makeFeasible(Xj);
@@ -159,13 +150,12 @@ void MMKP_COA::verticalCrossover(std::vector<MMKPSolution>& population){
     for(int i=0;i<D;i++){
         temp[i] = i;
     }
-    std::random_shuffle(temp,temp+D);
+    std::shuffle(temp,temp+D,this->rng);
     
     for(int i=0;i<(D/2);i++){
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
         std::uniform_real_distribution<> dis(0, 1);
-        float p = dis(gen);
+        float p = dis(this->rng);
         
         if (p<this->parameters.verticalCrossProb){
             
@@ -175,7 +165,7 @@ void MMKP_COA::verticalCrossover(std::vector<MMKPSolution>& population){
             for(int j=0;j<M;j++){
                 
                 std::uniform_int_distribution<> rs(0, 1);
-                int r = rs(gen);
+                int r = rs(this->rng);
                 
                 MMKPSolution Xi = population[j];
                 
@@ -45,6 +45,7 @@
 
 #include "MMKP_MetaHeuristic.h"
 #include "MMKPSolution.h"
+#include "MMKPBitSolution.h"
 #include "MMKPDataSet.h"
 
 /**
@@ -35,8 +35,9 @@ MMKPSolution MMKP_GA::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
 
     
     //main loop
@@ -49,12 +50,12 @@ MMKPSolution MMKP_GA::run(std::vector<MMKPSolution> initialPopulation){
         MMKP_GA::Mutate(newSol);
         
         float feas = MMKP_GA::makeFeasible(newSol);
+        //replace the worst solution, the rest stays sorted
         if(feas){
-            population[(population.size()-1)] = newSol;
+            std::swap(population[(population.size()-1)],newSol);
+            MMKPRanking::insertLast(population,this->dataSet);
         }
         
-        MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
-        
         for(int i=0;i<population.size();i++){
             if(this->dataSet.isFeasible(population[i])){
                 if(population[i].getProfit() > this->bestSolution.getProfit()){
@@ -70,8 +71,8 @@ MMKPSolution MMKP_GA::run(std::vector<MMKPSolution> initialPopulation){
             this->convergenceData.push_back(temp);
         }
         
-        if(currentGeneration >=
-           (this->parameters.numberOfGenerations*population.size())){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration/population.size(),
+                                            this->bestSolution.getProfit())){
             terminationCriterion = true;
         }
         
@@ -84,7 +85,7 @@ MMKPSolution MMKP_GA::run(std::vector<MMKPSolution> initialPopulation){
 std::vector<MMKPSolution> MMKP_GA::runOneGeneration
 (std::vector<MMKPSolution> population){
 
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
     
     //main loop
     for(int i=0;i<population.size();i++){
@@ -95,12 +96,12 @@ std::vector<MMKPSolution> MMKP_GA::runOneGeneration
         MMKP_GA::Mutate(newSol);
         
         float feas = MMKP_GA::makeFeasible(newSol);
+        //replace the worst solution, the rest stays sorted
         if(feas){
-            population[(population.size()-1)] = newSol;
+            std::swap(population[(population.size()-1)],newSol);
+            MMKPRanking::insertLast(population,this->dataSet);
         }
-        
-        MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
-        
+        this->currentFuncEvals += 1;
     }
     return population;
 }
@@ -116,8 +117,8 @@ void MMKP_GA::parentSelection
     
     //create 2 pools
     for(int i=0;i<this->parameters.parentPoolSizeT;i++){
-        int pool1 = rand() % population.size();
-        int pool2 = rand() % population.size();
+        int pool1 = this->rng.nextInt(population.size());
+        int pool2 = this->rng.nextInt(population.size());
         
         if(population[pool1].getProfit() > highP1){
             highP1 = population[pool1].getProfit();
@@ -139,7 +140,7 @@ MMKPSolution MMKP_GA::Crossover(MMKPSolution p1,MMKPSolution p2){
     
     for(int i=0;i<p1.size();i++){
         for(int j=0;j<p1[i].size();j++){
-            int r = rand() % 2;
+            int r = this->rng.nextInt(2);
             if(r != 0){
                 newSol[i][j] = p2[i][j];
             }//if r == 0, p1 bit's are already copied to newSol.
@@ -149,13 +150,11 @@ MMKPSolution MMKP_GA::Crossover(MMKPSolution p1,MMKPSolution p2){
 }
 
 void MMKP_GA::Mutate(MMKPSolution& solution){
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dif(0, 1);
     
     for(int i=0;i<solution.size();i++){
         for(int j=0;j<solution[i].size();j++){
-            float r = dif(gen);
+            float r = dif(this->rng);
             if(r < this->parameters.mutateProb){
                 if(solution[i][j] == 0){
                     solution[i][j] = 1;
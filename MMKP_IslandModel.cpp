@@ -0,0 +1,311 @@
+/*********************************************************
+ *
+ * File: MMKP_IslandModel.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of MMKP_IslandModel
+ *
+ *********************************************************/
+
+#include "MMKP_IslandModel.h"
+
+/* MMKP_IslandModel */
+
+MMKP_IslandModel::MMKP_IslandModel(MMKPDataSet dataSet,
+                                   IslandModel_parameters parameters)
+:MMKP_MetaHeuristic(dataSet,parameters),parameters(parameters),totalFuncEvals(0),
+isStopping(false){}
+
+MMKP_IslandModel::MMKP_IslandModel(MMKPDataSet dataSet)
+:MMKP_MetaHeuristic(dataSet,IslandModel_parameters()),parameters(),
+totalFuncEvals(0),isStopping(false){}
+
+void MMKP_IslandModel::addIsland(std::shared_ptr<MMKP_MetaHeuristic> heuristic){
+    assert(heuristic);
+    this->islands.push_back(heuristic);
+    this->queues.clear();
+}
+
+int MMKP_IslandModel::getNumberOfIslands(){
+    return this->islands.size();
+}
+
+//overloaded operators
+MMKPSolution MMKP_IslandModel::operator()
+(std::vector<MMKPSolution> initialPopulation){
+    return MMKP_IslandModel::run(initialPopulation);
+}
+
+MMKPSolution MMKP_IslandModel::run(std::vector<MMKPSolution> initialPopulation){
+    assert(!this->islands.empty());
+    assert(initialPopulation.size() >= this->islands.size());
+    
+    const int numberOfIslands = this->islands.size();
+    MMKP_IslandModel::connect();
+    std::vector<std::vector<MMKPSolution> > populations =
+        MMKP_IslandModel::split(initialPopulation);
+    
+    //every island gets its own stream, split before any thread starts.
+    //Migrants still arrive as the threads happen to run, so with migration
+    //on a seeded run does not repeat
+    std::vector<MMKPRandom> streams(numberOfIslands);
+    std::vector<MMKPSolution> islandBest(numberOfIslands);
+    std::vector<std::vector<std::tuple<int,float> > > histories(numberOfIslands);
+    for(int i=0;i<numberOfIslands;i++){
+        streams[i] = this->rng.split();
+        islandBest[i].setProfit(-1);
+    }
+    this->currentFuncEvals = 0;
+    this->totalFuncEvals = 0;
+    this->isStopping = false;
+    MMKP_MetaHeuristic::startBudget();
+    
+    this->pool->parallelFor(numberOfIslands,[&](int i){
+        MMKP_IslandModel::runIsland(i,populations[i],streams[i],islandBest[i],
+                                    histories[i]);
+    });
+    
+    MMKPSolution bestSolution;
+    bestSolution.setProfit(-1);
+    for(int i=0;i<numberOfIslands;i++){
+        if(islandBest[i].getProfit() > bestSolution.getProfit()){
+            bestSolution = islandBest[i];
+        }
+    }
+    
+    //merge island histories generation by generation, an island that
+    //stopped early keeps its last entry
+    std::size_t numberOfGenerations = 0;
+    for(int i=0;i<numberOfIslands;i++){
+        numberOfGenerations = std::max(numberOfGenerations,histories[i].size());
+    }
+    this->convergenceData.clear();
+    this->convergenceIteration = 0;
+    for(std::size_t g=0;g<numberOfGenerations;g++){
+        int funcEvals = 0;
+        float profit = -1;
+        for(int i=0;i<numberOfIslands;i++){
+            if(histories[i].empty()){continue;}
+            std::size_t last = std::min(g,histories[i].size()-1);
+            funcEvals += std::get<0>(histories[i][last]);
+            profit = std::max(profit,std::get<1>(histories[i][last]));
+        }
+        if((this->convergenceIteration == 0) &&
+           (profit >= bestSolution.getProfit()) && (profit >= 0)){
+            this->convergenceIteration = g+1;
+        }
+        this->currentFuncEvals = funcEvals;
+        this->convergenceData.push_back(std::tuple<int,float>(funcEvals,profit));
+    }
+    
+    //no feasible solution found, return the best of all islands
+    if(bestSolution.getProfit() < 0){
+        std::vector<MMKPSolution> population;
+        for(int i=0;i<numberOfIslands;i++){
+            population.insert(population.end(),populations[i].begin(),
+                              populations[i].end());
+        }
+        MMKP_MetaHeuristic::sortPopulationTop(population,1);
+        bestSolution = population[0];
+    }
+    return bestSolution;
+}
+
+std::vector<MMKPSolution> MMKP_IslandModel::runOneGeneration
+(std::vector<MMKPSolution> population){
+    assert(!this->islands.empty());
+    
+    const int numberOfIslands = this->islands.size();
+    if(this->queues.size() != (std::size_t)numberOfIslands*numberOfIslands){
+        MMKP_IslandModel::connect();
+    }
+    std::vector<std::vector<MMKPSolution> > populations =
+        MMKP_IslandModel::split(population);
+    
+    std::vector<int> funcEvals(numberOfIslands);
+    this->pool->parallelFor(numberOfIslands,[&](int i){
+        funcEvals[i] = this->islands[i]->getFuncEvals();
+        populations[i] = this->islands[i]->runOneGeneration(populations[i]);
+        funcEvals[i] = this->islands[i]->getFuncEvals()-funcEvals[i];
+    });
+    for(int i=0;i<numberOfIslands;i++){
+        this->currentFuncEvals += funcEvals[i];
+    }
+    
+    //migrate one island after another, so the result is repeatable
+    this->currentGeneration++;
+    if((this->parameters.migrationInterval > 0) &&
+       (this->currentGeneration%this->parameters.migrationInterval == 0)){
+        for(int i=0;i<numberOfIslands;i++){
+            MMKP_MetaHeuristic::sortPopulationTop(populations[i],
+                                                  this->parameters.numberOfMigrants);
+            MMKP_IslandModel::emigrate(i,populations[i],this->rng);
+        }
+        for(int i=0;i<numberOfIslands;i++){
+            MMKP_IslandModel::immigrate(i,populations[i]);
+        }
+    }
+    
+    population.clear();
+    for(int i=0;i<numberOfIslands;i++){
+        population.insert(population.end(),populations[i].begin(),
+                          populations[i].end());
+    }
+    return population;
+}
+
+//private helpers
+void MMKP_IslandModel::connect(){
+    const int numberOfIslands = this->islands.size();
+    const int topology = this->parameters.topology;
+    if((topology != MIGRATE_RING) && (topology != MIGRATE_FULL) &&
+       (topology != MIGRATE_RANDOM)){
+        throw OpNotSupported(("Migration topology not recognized.\n"));
+    }
+    
+    //room for a few migrations, in case the receiving island lags behind
+    std::size_t capacity = 4*std::max(1,this->parameters.numberOfMigrants);
+    this->queues.assign(numberOfIslands*numberOfIslands,
+                        std::shared_ptr<SpscQueue<MMKPSolution> >());
+    for(int from=0;from<numberOfIslands;from++){
+        for(int to=0;to<numberOfIslands;to++){
+            if(from == to){continue;}
+            if((topology == MIGRATE_RING) && (to != (from+1)%numberOfIslands)){
+                continue;
+            }
+            this->queues[from*numberOfIslands+to].reset
+                (new SpscQueue<MMKPSolution>(capacity));
+        }
+    }
+    
+    if(!this->pool || (this->pool->size() != numberOfIslands)){
+        this->pool.reset(new ThreadPool(numberOfIslands));
+    }
+    
+    //the heuristic of every island draws from its own split of rng
+    for(int i=0;i<numberOfIslands;i++){
+        this->islands[i]->setRandom(this->rng.split());
+    }
+}
+
+std::vector<std::vector<MMKPSolution> > MMKP_IslandModel::split
+(std::vector<MMKPSolution> population){
+    const int numberOfIslands = this->islands.size();
+    MMKP_MetaHeuristic::sortPopulation(population);
+    
+    std::vector<std::vector<MMKPSolution> > populations(numberOfIslands);
+    for(std::size_t i=0;i<population.size();i++){
+        populations[i%numberOfIslands].push_back(population[i]);
+    }
+    return populations;
+}
+
+void MMKP_IslandModel::emigrate(int island, std::vector<MMKPSolution>& population,
+                                MMKPRandom& rng){
+    const int numberOfIslands = this->islands.size();
+    const int numberOfMigrants = std::min<int>(this->parameters.numberOfMigrants,
+                                               population.size());
+    if((numberOfIslands < 2) || (numberOfMigrants < 1)){return;}
+    
+    //queues of the receiving islands
+    std::vector<SpscQueue<MMKPSolution>*> destinations;
+    if(this->parameters.topology == MIGRATE_RANDOM){
+        int to = rng.nextInt(numberOfIslands-1);
+        if(to >= island){to++;}
+        destinations.push_back(this->queues[island*numberOfIslands+to].get());
+    }else{
+        for(int to=0;to<numberOfIslands;to++){
+            SpscQueue<MMKPSolution>* queue =
+                this->queues[island*numberOfIslands+to].get();
+            if(queue != NULL){
+                destinations.push_back(queue);
+            }
+        }
+    }
+    
+    for(std::size_t d=0;d<destinations.size();d++){
+        for(int k=0;k<numberOfMigrants;k++){
+            //a full queue drops the migrant, never wait on the receiver
+            if(!destinations[d]->push(population[k])){break;}
+        }
+    }
+}
+
+int MMKP_IslandModel::immigrate(int island, std::vector<MMKPSolution>& population){
+    const int numberOfIslands = this->islands.size();
+    MMKP_MetaHeuristic::sortPopulation(population);
+    
+    int count = 0;
+    MMKPSolution migrant;
+    for(int from=0;from<numberOfIslands;from++){
+        SpscQueue<MMKPSolution>* queue =
+            this->queues[from*numberOfIslands+island].get();
+        if(queue == NULL){continue;}
+        while(queue->pop(migrant)){
+            //each migrant competes with one of the worst solutions
+            if(count < population.size()){
+                MMKP_MetaHeuristic::competitiveUpdateSol
+                    (population[(population.size()-1)-count],migrant);
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void MMKP_IslandModel::runIsland(int island, std::vector<MMKPSolution>& population,
+                                 MMKPRandom& rng, MMKPSolution& islandBest,
+                                 std::vector<std::tuple<int,float> >& history){
+    MMKP_MetaHeuristic& heuristic = *this->islands[island];
+    int funcEvals = 0;
+    int stagnantGenerations = 0;
+    
+    for(int g=1;(this->parameters.numberOfGenerations < 0) ||
+        (g <= this->parameters.numberOfGenerations);g++){
+        if(this->isStopping.load(std::memory_order_relaxed)){break;}
+        
+        //count exactly what the island's heuristic evaluated
+        int islandFuncEvals = heuristic.getFuncEvals();
+        population = heuristic.runOneGeneration(population);
+        islandFuncEvals = heuristic.getFuncEvals()-islandFuncEvals;
+        funcEvals += islandFuncEvals;
+        int totalFuncEvals = (this->totalFuncEvals += islandFuncEvals);
+        
+        if((this->parameters.migrationInterval > 0) &&
+           (g%this->parameters.migrationInterval == 0)){
+            MMKP_MetaHeuristic::sortPopulationTop(population,
+                                                  this->parameters.numberOfMigrants);
+            MMKP_IslandModel::emigrate(island,population,rng);
+            MMKP_IslandModel::immigrate(island,population);
+        }
+        
+        float previousBest = islandBest.getProfit();
+        for(std::size_t i=0;i<population.size();i++){
+            this->dataSet.updateSolution(population[i]);
+            if(this->dataSet.isFeasible(population[i]) &&
+               (population[i].getProfit() > islandBest.getProfit())){
+                islandBest = population[i];
+            }
+        }
+        history.push_back(std::tuple<int,float>(funcEvals,
+                                                islandBest.getProfit()));
+        
+        //budgets, the time, evaluation and target budgets stop all islands
+        stagnantGenerations = (islandBest.getProfit() > previousBest) ?
+            0 : stagnantGenerations+1;
+        if((this->parameters.maxStagnantGenerations > 0) &&
+           (stagnantGenerations >= this->parameters.maxStagnantGenerations)){
+            break;
+        }
+        if(((this->parameters.maxFuncEvals > 0) &&
+            (totalFuncEvals >= this->parameters.maxFuncEvals)) ||
+           ((this->parameters.targetProfit > 0) &&
+            (islandBest.getProfit() >= this->parameters.targetProfit)) ||
+           MMKP_MetaHeuristic::isBudgetExhausted()){
+            this->isStopping.store(true,std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/*********************************************************
+ *
+ * File: MMKP_IslandModel.h
+ * Author: Ken Zyma
+ *
+ * Island model running several metaheuristics in parallel with migration.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____MMKP_IslandModel__
+#define ____MMKP_IslandModel__
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <atomic>
+#include <assert.h>
+
+#include "MMKP_MetaHeuristic.h"
+#include "MMKPSolution.h"
+#include "MMKPDataSet.h"
+#include "MMKPRandom.h"
+#include "SpscQueue.h"
+#include "ThreadPool.h"
+
+/**
+ * <p>Migration topologies of the island model:
+ * <lu>
+ * <li>MIGRATE_RING = island i sends its migrants to island i+1.</li>
+ * <li>MIGRATE_FULL = every island sends its migrants to all others.</li>
+ * <li>MIGRATE_RANDOM = every island sends its migrants to one randomly
+ * choosen other island, choosen again at each migration.</li>
+ * </lu></p>
+ */
+enum migrationTopology{
+    MIGRATE_RING = 0,
+    MIGRATE_FULL = 1,
+    MIGRATE_RANDOM = 2
+};
+
+/**
+ * Parameters for customizing the island model. numberOfGenerations is the
+ * number of generations each island runs. The time, function evaluation
+ * (all islands together) and target profit budgets stop every island, the
+ * stagnation budget stops a single island. Every migrationInterval
+ * generations an island sends copies of its numberOfMigrants best
+ * solutions to its neighbours (see migrationTopology) and takes in the
+ * migrants that have arrived.
+ */
+class IslandModel_parameters:public MetaHeuristic_parameters{
+public:
+    int topology;
+    int migrationInterval;
+    int numberOfMigrants;
+    
+    IslandModel_parameters(){
+        this->topology = MIGRATE_RING;
+        this->migrationInterval = 5;
+        this->numberOfMigrants = 2;
+    }
+};
+
+/**
+ * Island model for running several metaheuristics on one problem at once.
+ * Each island is any MMKP_MetaHeuristic, advanced with runOneGeneration on
+ * its own part of the population and on its own thread. Islands exchange
+ * solutions through one lock-free queue (SpscQueue) per pair of connected
+ * islands, so migration never blocks: migrants that do not fit in a full
+ * queue are dropped and an island takes in whatever has arrived when it
+ * migrates.
+ *
+ * The heuristic of an island must be owned by that island alone and its
+ * populationSize parameter should match the part of the population it is
+ * given (run splits the population evenly).
+ */
+class MMKP_IslandModel:public MMKP_MetaHeuristic{
+private:
+    IslandModel_parameters parameters;
+    std::vector<std::shared_ptr<MMKP_MetaHeuristic> > islands;
+    std::vector<std::shared_ptr<SpscQueue<MMKPSolution> > > queues;
+    std::shared_ptr<ThreadPool> pool;
+    std::atomic<int> totalFuncEvals;
+    std::atomic<bool> isStopping;
+    
+    /**
+     * Create the queues connecting the islands, queues[from*N+to], and a
+     * pool with one thread per island, and give the heuristic of every
+     * island its own stream split from rng.
+     */
+    void connect();
+    
+    /**
+     * Deal population, best first, to the islands in turn.
+     */
+    std::vector<std::vector<MMKPSolution> > split
+    (std::vector<MMKPSolution> population);
+    
+    /**
+     * Send copies of the best solutions of param: population to the
+     * neighbours of param: island. Param: population must have its
+     * numberOfMigrants best solutions first (see sortPopulationTop).
+     */
+    void emigrate(int island, std::vector<MMKPSolution>& population,
+                  MMKPRandom& rng);
+    
+    /**
+     * Take in all migrants that have arrived at param: island, each one
+     * competing (competitiveUpdateSol) with one of the worst solutions of
+     * param: population. Return number of migrants taken in.
+     */
+    int immigrate(int island, std::vector<MMKPSolution>& population);
+    
+    /**
+     * Run all generations of param: island on param: population. Param:
+     * history receives the function evaluations and best feasible profit of
+     * the island after each generation.
+     */
+    void runIsland(int island, std::vector<MMKPSolution>& population,
+                   MMKPRandom& rng, MMKPSolution& islandBest,
+                   std::vector<std::tuple<int,float> >& history);
+public:
+    /**
+     * Construct MMKP_IslandModel object, without islands (see addIsland).
+     * Param: parameters can customize the model according to an instance
+     * of IslandModel_parameters.
+     */
+    MMKP_IslandModel(MMKPDataSet dataSet, IslandModel_parameters parameters);
+    
+    /**
+     * Construct MMKP_IslandModel object. Uses default parameters.
+     */
+    MMKP_IslandModel(MMKPDataSet dataSet);
+    
+    /**
+     * Add an island running param: heuristic.
+     */
+    void addIsland(std::shared_ptr<MMKP_MetaHeuristic> heuristic);
+    
+    /**
+     * Return number of islands.
+     */
+    int getNumberOfIslands();
+    
+    MMKPSolution operator()(std::vector<MMKPSolution> initialPopulation);
+    
+    /**
+     * Split initialPopulation over the islands and run every island for
+     * numberOfGenerations generations, all islands at once. Return the best
+     * feasible solution found on any island. Convergence data holds, per
+     * generation, the function evaluations counted by the heuristics of all
+     * islands (see getFuncEvals) and the best profit of all islands.
+     * Islands take in whatever migrants have arrived, so with migration on
+     * the result depends on thread timing even for a fixed seed, use
+     * runOneGeneration for repeatable runs.
+     */
+    MMKPSolution run(std::vector<MMKPSolution> initialPopulation);
+    
+    /**
+     * Split population over the islands, run one generation of every island
+     * at once and migrate every migrationInterval calls. Return the islands
+     * populations joined together. Islands migrate one after another, so
+     * the result repeats for a fixed seed.
+     */
+    std::vector<MMKPSolution> runOneGeneration
+    (std::vector<MMKPSolution> population);
+};
+
+#endif /* defined(____MMKP_IslandModel__) */
@@ -12,12 +12,74 @@
 
 #include "MMKP_LocalSearch.h"
 
-LocalSearch::LocalSearch(MMKPDataSet dataSet):dataSet(dataSet),funcEvals(0){}
+/* ProfitPenalty */
+
+void ProfitPenalty::penalize(const MMKPFlatData& flatData, int classI,
+                             int itemI, float factor){
+    if(factor == 1){return;}
+    if(this->factors.size() != flatData.getNumberOfItems()){
+        this->clear();
+        this->factors.assign(flatData.getNumberOfItems(),1);
+    }
+    int item = flatData.getItemIndex(classI,itemI);
+    if(this->factors[item] == 1){
+        this->penalized.push_back(std::pair<int,int>(classI,itemI));
+        this->items.push_back(item);
+    }
+    this->factors[item] *= factor;
+}
+
+void ProfitPenalty::clear(){
+    for(std::size_t i=0;i<this->items.size();i++){
+        this->factors[this->items[i]] = 1;
+    }
+    this->penalized.clear();
+    this->items.clear();
+}
+
+/* LocalSearch */
+
+LocalSearch::LocalSearch(MMKPDataSet dataSet):dataSet(dataSet),funcEvals(0),
+rng(MMKPRandom::randomSeed()){}
+
+LocalSearch::LocalSearch(MMKPDataSet dataSet, MMKPRandom rng)
+:dataSet(dataSet),funcEvals(0),rng(rng){}
 
 int LocalSearch::getFuncEvals(){
     return this->funcEvals;
 }
 
+ProfitPenalty& LocalSearch::getPenalty(){
+    return this->penalty;
+}
+
+void LocalSearch::setThreadPool(std::shared_ptr<ThreadPool> pool){
+    this->pool = pool;
+}
+
+void LocalSearch::updateSolution(MMKPSolution& solution) const{
+    this->dataSet.updateSolution(solution);
+    LocalSearch::addPenalty(solution);
+}
+
+void LocalSearch::addPenalty(MMKPSolution& solution) const{
+    if(this->penalty.empty()){return;}
+    
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const std::vector<std::pair<int,int> >& penalized =
+        this->penalty.getPenalized();
+    float profit = solution.getProfit();
+    for(std::size_t i=0;i<penalized.size();i++){
+        int classI = penalized[i].first;
+        int itemI = penalized[i].second;
+        if(solution[classI][itemI]){
+            int item = flatData.getItemIndex(classI,itemI);
+            profit += flatData.getProfit(item)*(this->penalty.getFactor(item)-1);
+        }
+    }
+    solution.setProfit(profit);
+}
+
 int LocalSearch::localSwapProcedure(MMKPSolution solution,int classI){
     
     dataSet.updateSolution(solution);
@@ -30,7 +92,7 @@ int LocalSearch::localSwapProcedure(MMKPSolution solution,int classI){
     for(int i=0;i<solution[classI].size();i++){
         if(solution[classI][i]){
             selIndex = i;
-            selProfit = dataSet[classI][i].getProfit();
+            selProfit = LocalSearch::getProfit(classI,i);
             break;
         }
     }
@@ -46,7 +108,7 @@ int LocalSearch::localSwapProcedure(MMKPSolution solution,int classI){
     
     for(int i=0;i<solution[classI].size();i++){
         bool isViolation = false;
-        if(dataSet[classI][i].getProfit() <= dataSet[classI][maxIndex].getProfit()){
+        if(LocalSearch::getProfit(classI,i) <= LocalSearch::getProfit(classI,maxIndex)){
             continue;
         }
         //make sure does not violate any resource contraints
@@ -67,60 +129,75 @@ int LocalSearch::localSwapProcedure(MMKPSolution solution,int classI){
 
 CompLocalSearch::CompLocalSearch(MMKPDataSet dataSet):LocalSearch(dataSet){}
 
+CompLocalSearch::CompLocalSearch(MMKPDataSet dataSet, MMKPRandom rng)
+:LocalSearch(dataSet,rng){}
+
 MMKPSolution CompLocalSearch::run(MMKPSolution solution){
     
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int numberOfClasses = solution.size();
+    const int numberOfResources = flatData.getNumberOfResources();
     MMKPSolution newSol = solution;
+    float solutionProfit = solution.getProfit();
     
-    bool stoppingCriterion = false;
+    CompLocalSearch::prepare(newSol);
+    for(int i=0;i<numberOfClasses;i++){
+        CompLocalSearch::findBestSwap(i,flatData.getClassOffset(i));
+    }
     
-    while(!stoppingCriterion){
-        int bestIndex = 0;
+    while(true){
         int bestClassIndex = 0;
         float bestProfit = -1;
-        int selIndex = 0;
         
-        for(int i=0;i<newSol.size();i++){
-            
-            //get selected index
-            for(int j=0;j<solution[i].size();j++){
-                if(newSol[i][j]){
-                    selIndex = j;
-                }
+        //find 'swap' which will optimize our objective function
+        for(int i=0;i<numberOfClasses;i++){
+            float profit = 0;
+            if(this->bestPosition[i] >= 0){
+                profit = LocalSearch::getProfit(this->order[this->bestPosition[i]])
+                    - LocalSearch::getProfit(this->selected[i]);
             }
-            
-            //get new swap index
-            int indx = LocalSearch::localSwapProcedure(newSol,i);
-            
-            //find 'swap' which will optimize our objective function
-            if((dataSet[i][indx].getProfit() - dataSet[i][selIndex].getProfit())
-               > bestProfit){
-                bestIndex = indx;
-                bestProfit = dataSet[i][indx].getProfit()
-                    - dataSet[i][selIndex].getProfit();
+            if(profit > bestProfit){
+                bestProfit = profit;
                 bestClassIndex = i;
             }
-            //not a function evaluation, but the meat of this example is here
             funcEvals++;
         }
         
         //swap for largest profit increase
-        int swapIndex = 0;
-        for(int i=0;i<newSol[bestClassIndex].size();i++){
-            if(newSol[bestClassIndex][i]){
-                swapIndex = i;
-            }
-        }
         funcEvals++;
-        newSol[bestClassIndex][swapIndex] = 0;
-        newSol[bestClassIndex][bestIndex] = 1;
-        
-        dataSet.updateSolution(newSol);
+        if(this->bestPosition[bestClassIndex] >= 0){
+            const int offset = flatData.getClassOffset(bestClassIndex);
+            int item = this->order[this->bestPosition[bestClassIndex]];
+            newSol[bestClassIndex][this->selected[bestClassIndex]-offset] = 0;
+            newSol[bestClassIndex][item-offset] = 1;
+            this->selected[bestClassIndex] = item;
+        }
+        this->previousResidual.swap(this->residual);
+        CompLocalSearch::evaluate(newSol);
         
         //stopping criterion if no progress is made.
-        if(newSol.getProfit() <= solution.getProfit()){
-            stoppingCriterion = true;
-        }else{
-            solution = newSol;
+        if(newSol.getProfit() <= solutionProfit){
+            break;
+        }
+        solutionProfit = newSol.getProfit();
+        
+        //items that did not fit still do not, unless some capacity grew
+        bool isResidualGrown = false;
+        for(int k=0;k<numberOfResources;k++){
+            if(this->residual[k] > this->previousResidual[k]){
+                isResidualGrown = true;
+                break;
+            }
+        }
+        for(int i=0;i<numberOfClasses;i++){
+            int position = this->bestPosition[i];
+            if((i == bestClassIndex) || isResidualGrown){
+                CompLocalSearch::findBestSwap(i,flatData.getClassOffset(i));
+            }else if((position >= 0) &&
+                     !CompLocalSearch::isAdmissible(this->order[position],
+                                                    this->selected[i])){
+                CompLocalSearch::findBestSwap(i,position+1);
+            }
         }
     }
     
@@ -129,14 +206,144 @@ MMKPSolution CompLocalSearch::run(MMKPSolution solution){
     return newSol;
 }
 
+void CompLocalSearch::sortClass(int classI){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    std::sort(this->order.begin()+flatData.getClassOffset(classI),
+              this->order.begin()+flatData.getClassOffset(classI+1),
+              [this](int a, int b){
+                  float profitA = LocalSearch::getProfit(a);
+                  float profitB = LocalSearch::getProfit(b);
+                  return (profitA > profitB) || ((profitA == profitB) && (a < b));
+              });
+}
+
+void CompLocalSearch::prepare(MMKPSolution& solution){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int numberOfClasses = solution.size();
+    
+    //sort every class once, after that only those a penalty changed
+    if(this->order.size() != flatData.getNumberOfItems()){
+        this->order.resize(flatData.getNumberOfItems());
+        for(int i=0;i<flatData.getNumberOfItems();i++){
+            this->order[i] = i;
+        }
+        for(int i=0;i<numberOfClasses;i++){
+            CompLocalSearch::sortClass(i);
+        }
+    }else{
+        for(std::size_t i=0;i<this->sortedClasses.size();i++){
+            CompLocalSearch::sortClass(this->sortedClasses[i]);
+        }
+    }
+    this->sortedClasses.clear();
+    const std::vector<std::pair<int,int> >& penalized =
+        this->penalty.getPenalized();
+    for(std::size_t i=0;i<penalized.size();i++){
+        CompLocalSearch::sortClass(penalized[i].first);
+        this->sortedClasses.push_back(penalized[i].first);
+    }
+    
+    this->selected.resize(numberOfClasses);
+    this->bestPosition.resize(numberOfClasses);
+    for(int i=0;i<numberOfClasses;i++){
+        for(int j=0;j<solution[i].size();j++){
+            if(solution[i][j]){
+                this->selected[i] = flatData.getItemIndex(i,j);
+            }
+        }
+    }
+    CompLocalSearch::evaluate(solution);
+    assert(dataSet.isFeasible(solution));
+}
+
+void CompLocalSearch::evaluate(MMKPSolution& solution){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int numberOfResources = flatData.getNumberOfResources();
+    
+    //same order of summation as MMKPDataSet::updateSolution
+    this->costs.assign(numberOfResources,0);
+    float profit = 0;
+    for(std::size_t i=0;i<this->selected.size();i++){
+        profit += flatData.getProfit(this->selected[i]);
+        const float* costs = flatData.getCosts(this->selected[i]);
+        for(int k=0;k<numberOfResources;k++){
+            this->costs[k] += costs[k];
+        }
+    }
+    solution.setProfit(profit);
+    solution.setCosts(this->costs);
+    LocalSearch::addPenalty(solution);
+    
+    this->residual.resize(numberOfResources);
+    for(int k=0;k<numberOfResources;k++){
+        this->residual[k] = this->dataSet.getResource(k) - this->costs[k];
+    }
+}
+
+bool CompLocalSearch::isAdmissible(int item, int selectedItem){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int numberOfResources = flatData.getNumberOfResources();
+    const float* costs = flatData.getCosts(item);
+    const float* selectedCosts = flatData.getCosts(selectedItem);
+    funcEvals += numberOfResources;
+    for(int k=0;k<numberOfResources;k++){
+        if(this->residual[k] < (costs[k] - selectedCosts[k])){
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompLocalSearch::findBestSwap(int classI, int from){
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int end = flatData.getClassOffset(classI+1);
+    const float selectedProfit = LocalSearch::getProfit(this->selected[classI]);
+    //an item dominating a dominated one has at least its profit and fits
+    //whenever it does, unless a penalty lowered its profit
+    const bool isSkippingDominated = this->penalty.getPenalized().empty();
+    this->bestPosition[classI] = -1;
+    for(int position=from;position<end;position++){
+        int item = this->order[position];
+        if(LocalSearch::getProfit(item) <= selectedProfit){
+            break;
+        }
+        if(isSkippingDominated && flatData.isDominated(item)){
+            continue;
+        }
+        if(CompLocalSearch::isAdmissible(item,this->selected[classI])){
+            this->bestPosition[classI] = position;
+            break;
+        }
+    }
+}
+
 MMKPSolution CompLocalSearch::operator()(MMKPSolution solution){
     return run(solution);
 }
 
 std::vector<MMKPSolution> CompLocalSearch::run(std::vector<MMKPSolution> solutions){
-    for(int i=0;i<solutions.size();i++){
-        solutions[i] = CompLocalSearch::run(solutions[i]);
+    if(!this->pool || (solutions.size() < 2)){
+        for(int i=0;i<solutions.size();i++){
+            solutions[i] = CompLocalSearch::run(solutions[i]);
+        }
+        return solutions;
     }
+    
+    //one copy (and so one set of scratch buffers) per thread, each takes
+    //the next solution until all are done
+    const int numberOfWorkers = std::min<int>(this->pool->size(),solutions.size());
+    std::vector<CompLocalSearch> workers(numberOfWorkers,*this);
+    std::atomic<int> nextSolution(0);
+    std::atomic<int> funcEvals(0);
+    this->pool->parallelFor(numberOfWorkers,[&](int t){
+        CompLocalSearch& worker = workers[t];
+        worker.funcEvals = 0;
+        for(int i=nextSolution++;i<solutions.size();i=nextSolution++){
+            solutions[i] = worker.run(solutions[i]);
+        }
+        funcEvals += worker.funcEvals;
+    });
+    this->funcEvals += funcEvals;
     return solutions;
 }
 
@@ -145,51 +352,49 @@ std::vector<MMKPSolution> CompLocalSearch::operator()
     return run(solutions);
 }
 
-MMKPDataSet ReactiveLocalSearch::penalize
-(MMKPSolution solution,int delta, float pie){
+void ReactiveLocalSearch::penalize
+(MMKPSolution& solution,int delta, float pie){
     
-    MMKPDataSet newDataSet = this->dataSet;
+    ProfitPenalty& penalty = this->CLS.getPenalty();
+    penalty.clear();
     for(int i=0;i<delta;i++){
-        int classI = rand() % solution.size();
+        int classI = this->rng.nextInt(solution.size());
         int itemI = 0;
         for(int j=0;j<solution[classI].size();j++){
-            if(solution[i][j]){
+            if(solution[classI][j]){
                 itemI = j;
                 break;
             }
         }
-        float p = newDataSet[classI][itemI].getProfit();
-        newDataSet[classI][itemI].setProfit(p*pie);
+        penalty.penalize(this->dataSet.getFlatData(),classI,itemI,pie);
     }
-    return newDataSet;
 }
 
 ReactiveLocalSearch::ReactiveLocalSearch(MMKPDataSet dataSet)
-:LocalSearch(dataSet){}
+:LocalSearch(dataSet),CLS(dataSet,this->rng){}
+
+ReactiveLocalSearch::ReactiveLocalSearch(MMKPDataSet dataSet, MMKPRandom rng)
+:LocalSearch(dataSet,rng),CLS(dataSet,rng){}
 
 MMKPSolution ReactiveLocalSearch::run(MMKPSolution solution){
     
     MMKPSolution newSol = solution;
-    MMKPDataSet newDataSet = dataSet;
-    
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> ud(0, 1);
+    this->CLS.getPenalty().clear();
     
     for(int i=0;i<10;i++){
         
-        float pie = ud(gen);
-        int delta = rand() % solution.size();
+        float pie = this->rng.nextFloat();
+        int delta = this->rng.nextInt(solution.size());
         
-        CompLocalSearch CLS(newDataSet);
-        newSol = CLS(newSol);
-        this->funcEvals += CLS.getFuncEvals();
+        int funcEvals = this->CLS.getFuncEvals();
+        newSol = this->CLS(newSol);
+        this->funcEvals += this->CLS.getFuncEvals() - funcEvals;
         if(solution.getProfit()<newSol.getProfit()){
             solution = newSol;
             dataSet.updateSolution(solution);
-            newDataSet = this->dataSet;
+            this->CLS.getPenalty().clear();
         }else{
-            newDataSet = ReactiveLocalSearch::penalize(newSol,delta,pie);
+            ReactiveLocalSearch::penalize(newSol,delta,pie);
         }
         
     }
@@ -203,9 +408,31 @@ MMKPSolution ReactiveLocalSearch::operator()
 
 std::vector<MMKPSolution> ReactiveLocalSearch::run
 (std::vector<MMKPSolution> solutions){
-    for(int i=0;i<solutions.size();i++){
-        solutions[i] = ReactiveLocalSearch::run(solutions[i]);
+    std::vector<MMKPRandom> streams(solutions.size());
+    for(std::size_t i=0;i<solutions.size();i++){
+        streams[i] = this->rng.split();
+    }
+    
+    const int numberOfWorkers = this->pool ?
+        std::min<int>(this->pool->size(),solutions.size()) : 1;
+    std::vector<ReactiveLocalSearch> workers(numberOfWorkers,*this);
+    std::atomic<int> nextSolution(0);
+    std::atomic<int> funcEvals(0);
+    std::function<void(int)> task = [&](int t){
+        ReactiveLocalSearch& worker = workers[t];
+        worker.funcEvals = 0;
+        for(int i=nextSolution++;i<solutions.size();i=nextSolution++){
+            worker.rng = streams[i];
+            solutions[i] = worker.run(solutions[i]);
+        }
+        funcEvals += worker.funcEvals;
+    };
+    if(numberOfWorkers > 1){
+        this->pool->parallelFor(numberOfWorkers,task);
+    }else{
+        task(0);
     }
+    this->funcEvals += funcEvals;
     return solutions;
 }
 
@@ -34,6 +34,7 @@
 
 #include <iostream>
 #include <vector>
+#include <utility>
 #include <time.h>
 #include <cmath>
 #include <math.h>
@@ -43,9 +44,56 @@
 #include <cfloat>
 #include <algorithm> //for "random shuffle"
 #include <random>
+#include <memory>
+#include <atomic>
 
 #include "MMKPSolution.h"
 #include "MMKPDataSet.h"
+#include "MMKPRandom.h"
+#include "ThreadPool.h"
+
+/**
+ * Sparse overlay of profit multipliers on a MMKPDataSet, so items can be
+ * penalized without copying the dataset. Multipliers are kept per item
+ * (flat index, see MMKPFlatData) along with a list of the penalized
+ * items, so clearing only touches those.
+ */
+class ProfitPenalty{
+private:
+    std::vector<float> factors;
+    std::vector<std::pair<int,int> > penalized;  //(class, item)
+    std::vector<int> items;                     //flat index of each
+public:
+    /**
+     * Return true if no item is penalized.
+     */
+    bool empty() const{return penalized.empty();}
+    
+    /**
+     * Return the (class, item) pairs penalized since the last clear.
+     */
+    const std::vector<std::pair<int,int> >& getPenalized() const{
+        return penalized;
+    }
+    
+    /**
+     * Return multiplier of item (flat index) item.
+     */
+    float getFactor(int item) const{
+        return penalized.empty() ? 1 : factors[item];
+    }
+    
+    /**
+     * Multiply profit of item itemI in class classI by factor.
+     */
+    void penalize(const MMKPFlatData& flatData, int classI, int itemI,
+                  float factor);
+    
+    /**
+     * Remove all penalties.
+     */
+    void clear();
+};
 
 /**
  * Base/Helper class for all local search procedures.
@@ -54,8 +102,43 @@ class LocalSearch{
 protected:
     MMKPDataSet dataSet;
     int funcEvals;
+    MMKPRandom rng;
+    ProfitPenalty penalty;
+    std::shared_ptr<ThreadPool> pool;
+    
+    /**
+     * Return profit of item itemI in class classI, penalty included.
+     */
+    float getProfit(int classI, int itemI) const{
+        return getProfit(dataSet.getFlatData().getItemIndex(classI,itemI));
+    }
+    
+    /**
+     * Return profit of item (flat index) item, penalty included.
+     */
+    float getProfit(int item) const{
+        return dataSet.getFlatData().getProfit(item)*penalty.getFactor(item);
+    }
+    
+    /**
+     * Update solution analytics, penalty included.
+     */
+    void updateSolution(MMKPSolution& solution) const;
+    
+    /**
+     * Apply the penalty to the (unpenalized) profit of solution.
+     */
+    void addPenalty(MMKPSolution& solution) const;
 public:
+    /**
+     * Construct LocalSearch with a generator seeded from std::random_device.
+     */
     LocalSearch(MMKPDataSet dataSet);
+    
+    /**
+     * Construct LocalSearch taking random choices from param: rng.
+     */
+    LocalSearch(MMKPDataSet dataSet, MMKPRandom rng);
     virtual MMKPSolution run(MMKPSolution solution)=0;
     virtual MMKPSolution operator()(MMKPSolution solution)=0;
     virtual std::vector<MMKPSolution> run(std::vector<MMKPSolution> solutions)=0;
@@ -63,6 +146,18 @@ public:
     
     
     int getFuncEvals();
+    
+    /**
+     * Return the profit penalty applied on top of the dataset.
+     */
+    ProfitPenalty& getPenalty();
+    
+    /**
+     * Spread the solutions of the vector overloads of run over pool. A
+     * NULL pool runs them one after another.
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    
     /**
      *  Return suggested item to swap with in class @param class.
      */
@@ -73,15 +168,64 @@ public:
  * A Complementary Local Search Procedure based on the following paper:
  * Mhand Hifi et al. Heuristic algorithms for the multiple-choice
  * multidimensional knapsack problem.
+ *
+ * Each step swaps in the class whose best admissible item (most profitable
+ * item that fits the residual capacity) improves profit the most. The best
+ * swap of every class is cached between steps and only searched again when
+ * a step may have changed it: for the class swapped in, for every class if
+ * some residual capacity grew, and otherwise only for classes whose cached
+ * item no longer fits.
  */
 class CompLocalSearch:public LocalSearch{
 protected:
+    std::vector<int> order;         //items of each class, most profit first
+    std::vector<int> sortedClasses; //classes last sorted with a penalty
+    std::vector<int> selected;      //selected item of each class
+    std::vector<int> bestPosition;  //best swap of each class in order, or -1
+    std::vector<float> costs;
+    std::vector<float> residual;
+    std::vector<float> previousResidual;
+    
+    /**
+     * Sort the items of class classI in order by profit (penalty
+     * included), ties by index.
+     */
+    void sortClass(int classI);
+    
+    /**
+     * Set selected, the order of the items and the analytics of solution
+     * before a run.
+     */
+    void prepare(MMKPSolution& solution);
+    
+    /**
+     * Set profit and costs of solution from selected, and the residual
+     * capacity.
+     */
+    void evaluate(MMKPSolution& solution);
+    
+    /**
+     * Return true if item fits in place of the selected item of its class.
+     */
+    bool isAdmissible(int item, int selectedItem);
+    
+    /**
+     * Set bestPosition of class classI to the first admissible item
+     * improving profit, searching order from position from.
+     */
+    void findBestSwap(int classI, int from);
 public:
     /**
      * Constuct instance of CompLocalSearch.
      */
     CompLocalSearch(MMKPDataSet dataSet);
     
+    /**
+     * Constuct instance of CompLocalSearch taking random choices from
+     * param: rng.
+     */
+    CompLocalSearch(MMKPDataSet dataSet, MMKPRandom rng);
+    
     /**
      * Run a complementary local search on solution.
      */
@@ -93,7 +237,8 @@ public:
     MMKPSolution operator()(MMKPSolution solution);
     
     /**
-     * Run a complementary local search on all solutions in vector solutions.
+     * Run a complementary local search on all solutions in vector solutions,
+     * in parallel if a thread pool is set. Results are in input order.
      */
     std::vector<MMKPSolution> run(std::vector<MMKPSolution> solutions);
     
@@ -110,7 +255,13 @@ public:
  */
 class ReactiveLocalSearch:public LocalSearch{
 protected:
-    MMKPDataSet penalize(MMKPSolution solution,int delta, float pie);
+    CompLocalSearch CLS;
+    
+    /**
+     * Penalize the profit of the selected item in delta random classes of
+     * solution by factor pie, replacing the previous penalty of CLS.
+     */
+    void penalize(MMKPSolution& solution,int delta, float pie);
 public:
     
     /**
@@ -118,6 +269,12 @@ public:
      */
     ReactiveLocalSearch(MMKPDataSet dataSet);
     
+    /**
+     * Constuct instance of ReactiveLocalSearch taking random choices from
+     * param: rng, ex. a stream split from the calling heuristic.
+     */
+    ReactiveLocalSearch(MMKPDataSet dataSet, MMKPRandom rng);
+    
     /**
      * Run a reactive local search on a solution.
      */
@@ -129,7 +286,10 @@ public:
     MMKPSolution operator()(MMKPSolution solution);
     
     /**
-     * Run a reactive local search on all solutions in vector solutions.
+     * Run a reactive local search on all solutions in vector solutions,
+     * in parallel if a thread pool is set. Results are in input order.
+     * Each solution draws from its own stream split from rng, so the
+     * results do not depend on the number of threads.
      */
     std::vector<MMKPSolution> run(std::vector<MMKPSolution> solutions);
     
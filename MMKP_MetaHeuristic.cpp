@@ -12,6 +12,47 @@
 
 #include "MMKP_MetaHeuristic.h"
 
+/* MetaHeuristic_parameters */
+
+bool MetaHeuristic_parameters::parseBudget(const std::string& option){
+    std::size_t equals = option.find('=');
+    if((equals == std::string::npos) || (equals+1 == option.size())){
+        return false;
+    }
+    std::string name = option.substr(0,equals);
+    const char* value = option.c_str()+equals+1;
+    if(name == "time"){
+        this->timeLimit = atof(value);
+    }else if(name == "evals"){
+        this->maxFuncEvals = atoi(value);
+    }else if(name == "target"){
+        this->targetProfit = atof(value);
+    }else if(name == "stagnation"){
+        this->maxStagnantGenerations = atoi(value);
+    }else{
+        return false;
+    }
+    return true;
+}
+
+void MetaHeuristic_parameters::setBudgets(const MetaHeuristic_parameters& budgets){
+    this->timeLimit = budgets.timeLimit;
+    this->maxFuncEvals = budgets.maxFuncEvals;
+    this->targetProfit = budgets.targetProfit;
+    this->maxStagnantGenerations = budgets.maxStagnantGenerations;
+}
+
+/* MMKP_MetaHeuristic */
+
+/**
+ * Ranking buffers of the calling thread. Islands of an island model sort
+ * their populations at the same time.
+ */
+static MMKPRanking& getRanking(){
+    static thread_local MMKPRanking ranking;
+    return ranking;
+}
+
 void MMKP_MetaHeuristic::competitiveUpdateSol
 (MMKPSolution& sol, MMKPSolution& newSol){
     
@@ -35,53 +76,35 @@ void MMKP_MetaHeuristic::competitiveUpdateSol
     }
 }
 
-int MMKP_MetaHeuristic::partition(std::vector<MMKPSolution>& input,int p, int r){
-    //partition will sort greatest->least
-    int pivot = input[r].getProfit();
-    while ( p < r )
-    {
-        while ( input[p].getProfit() > pivot )
-            p++;
-        
-        while ( input[r].getProfit() < pivot )
-            r--;
-        
-        if ( input[p].getProfit() == input[r].getProfit() )
-            p++;
-        
-        else if (p < r )
-        {
-            MMKPSolution tmp = input[p];
-            input[p] = input[r];
-            input[r] = tmp;
-        }
-    }
-    
-    return r;
-}
-
-
 //constructors
 MMKP_MetaHeuristic::MMKP_MetaHeuristic(MMKPDataSet dataSet, MetaHeuristic_parameters parameters)
 :dataSet(dataSet),parameters(parameters),currentFuncEvals(0),convergenceIteration(0),
 currentGeneration(0){
-    srand(time(NULL));
+    this->rng.seed((parameters.seed != 0) ? parameters.seed : MMKPRandom::randomSeed());
+    MMKP_MetaHeuristic::startBudget();
 }
 
 MMKP_MetaHeuristic::MMKP_MetaHeuristic(MMKPDataSet dataSet)
 :dataSet(dataSet),parameters(),currentFuncEvals(0),convergenceIteration(0){
-    srand(time(NULL));
+    this->rng.seed(MMKPRandom::randomSeed());
+    MMKP_MetaHeuristic::startBudget();
 }
 
 MMKP_MetaHeuristic::~MMKP_MetaHeuristic(){};
 
-void MMKP_MetaHeuristic::quickSort(std::vector<MMKPSolution>& input,int p, int r){
-    if ( p < r )
-    {
-        int j = partition(input, p, r);
-        quickSort(input, p, j-1);
-        quickSort(input, j+1, r);
-    }
+void MMKP_MetaHeuristic::sortPopulation(std::vector<MMKPSolution>& population){
+    MMKPRanking& ranking = getRanking();
+    ranking.setKeys(population,this->dataSet);
+    ranking.sort();
+    ranking.permute(population);
+}
+
+void MMKP_MetaHeuristic::sortPopulationTop(std::vector<MMKPSolution>& population,
+                                           int k){
+    MMKPRanking& ranking = getRanking();
+    ranking.setKeys(population,this->dataSet);
+    ranking.sortTop(k);
+    ranking.permute(population);
 }
 
 std::vector<std::tuple<int,float> > MMKP_MetaHeuristic::getConvergenceData(){
@@ -92,6 +115,59 @@ int MMKP_MetaHeuristic::getConvergenceGeneration(){
     return convergenceIteration+1;
 }
 
+int MMKP_MetaHeuristic::getFuncEvals(){
+    return currentFuncEvals;
+}
+
+//mutator
+void MMKP_MetaHeuristic::setRandom(const MMKPRandom& rng){
+    this->rng = rng;
+}
+
+//budgets
+void MMKP_MetaHeuristic::startBudget(){
+    this->startTime = std::chrono::steady_clock::now();
+    this->stagnantProfit = -FLT_MAX;
+    this->stagnantGenerations = 0;
+    this->lastCheckedGeneration = -1;
+}
+
+bool MMKP_MetaHeuristic::isBudgetExhausted() const{
+    if((this->parameters.maxFuncEvals > 0) &&
+       (this->currentFuncEvals >= this->parameters.maxFuncEvals)){
+        return true;
+    }
+    if(this->parameters.timeLimit > 0){
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - this->startTime;
+        return (elapsed.count() >= this->parameters.timeLimit);
+    }
+    return false;
+}
+
+bool MMKP_MetaHeuristic::isTerminated(int generation, float bestProfit){
+    if((this->parameters.numberOfGenerations >= 0) &&
+       (generation >= this->parameters.numberOfGenerations)){
+        return true;
+    }
+    if((this->parameters.targetProfit > 0) &&
+       (bestProfit >= this->parameters.targetProfit)){
+        return true;
+    }
+    if((this->parameters.maxStagnantGenerations > 0) &&
+       (generation != this->lastCheckedGeneration)){
+        this->lastCheckedGeneration = generation;
+        if(bestProfit > this->stagnantProfit){
+            this->stagnantProfit = bestProfit;
+            this->stagnantGenerations = 0;
+        }else if(++this->stagnantGenerations >=
+                 this->parameters.maxStagnantGenerations){
+            return true;
+        }
+    }
+    return MMKP_MetaHeuristic::isBudgetExhausted();
+}
+
 bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol){
     return MMKP_MetaHeuristic::makeFeasible(sol,
                                    this->parameters.multipleChoiceFeasibilityMod,
@@ -99,6 +175,11 @@ bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol){
 }
 
 bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas){
+    return MMKP_MetaHeuristic::makeFeasible(sol,mcFeas,mdFeas,this->rng);
+}
+
+bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas,
+                                      MMKPRandom& rng){
     
     bool mcFeasible = false;
     bool mdFeasible = false;
@@ -107,17 +188,17 @@ bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas){
     if(mcFeas == CH_FIXEDMAX){
         mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasFixedSurrogate(sol);
     }else if(mcFeas == CH_FIXEDMAX_RANDOM){
-        mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(sol);
+        mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(sol,rng);
     }else if(mcFeas == CH_MAXPROFIT){
-        mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(sol);
+        mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(sol,rng);
     }else if(mcFeas == CH_MIX){
-        int choice = rand() % 2;
+        int choice = rng.nextInt(2);
         switch(choice){
             case 0:
-                mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(sol);
+                mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(sol,rng);
                 break;
             default:
-                mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(sol);
+                mcFeasible = MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(sol,rng);
                 break;
         }
     }else if(mcFeas == CH_NONE){
@@ -139,7 +220,7 @@ bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas){
     }else if(mdFeas == DIM_MAXPROFIT){
         mdFeasible = MMKP_MetaHeuristic::makeMultiDimFeasVarMaximizeProfit(sol);
     }else if(mdFeas == DIM_MIX){
-        int choice = rand() % 2;
+        int choice = rng.nextInt(2);
         switch(choice){
             case 0:
                 mdFeasible = MMKP_MetaHeuristic::makeMultiDimFeasVariableSurrogate(sol);
@@ -150,6 +231,8 @@ bool MMKP_MetaHeuristic::makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas){
         }
     }else if(mdFeas == DIM_NONE){
         //none
+    }else if(mdFeas == DIM_HEAPREPAIR){
+        mdFeasible = MMKP_MetaHeuristic::makeMultiDimFeasHeapRepair(sol);
     }else{
         //not supported
         throw OpNotSupported(("Multiple Dim feasibility num: "+
@@ -168,11 +251,14 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixedSurrogate(MMKPSolution& sol){
     
     if(dataSet.isMultiChoiceFeasible(sol)){return true;}
     
+    //the highest v/[Er%/n] of each class leads its candidate list
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    
     //step 2 from "draft of logic to convert MetaHeuristic Sol...
     for(int i=0;i<sol.size();i++){
         
         int sum = 0;
-        int h1 = 0;   //highest index of all v/[Er%/n] in a sol row
+        int h1 = flatData.getItemsByRatio(i)[0] - flatData.getClassOffset(i);
         int h2 = -1;   //highest index of selected v/[Er%/n] in a sol row
         
         for(int j=0;j<sol[i].size();j++){
@@ -182,10 +268,6 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixedSurrogate(MMKPSolution& sol){
         for(int j=0;j<sol[i].size();j++){
             sum += sol[i][j];
             
-            if(dataSet[i][j].getProfitConstraintUsePercent() >
-               dataSet[i][h1].getProfitConstraintUsePercent()){
-                h1 = j;
-            }
             if((sol[i][j]) && (dataSet[i][j].getProfitConstraintUsePercent() >
                                dataSet[i][h2].getProfitConstraintUsePercent())){
                 assert(h2 != -1);   //if nothing is selected and here, fail.
@@ -213,6 +295,11 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixedSurrogate(MMKPSolution& sol){
 }
 
 bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(MMKPSolution& sol){
+    return MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(sol,this->rng);
+}
+
+bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate
+(MMKPSolution& sol, MMKPRandom& rng){
     if(dataSet.isMultiChoiceFeasible(sol)){return true;}
     
     //step 2 from "draft of logic to convert MetaHeuristic Sol...
@@ -244,7 +331,7 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(MMKPSolution& s
             continue;
             //choose highest v/[Er%/n]
         }else if(sum == 0){
-            int r = rand() % sol[i].size();
+            int r = rng.nextInt(sol[i].size());
             sol[i][r] = true;
             //choose highest v/[Er%/n] of selected items,
             //all others should be unselected
@@ -261,13 +348,17 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasFixed_Rand_Surrogate(MMKPSolution& s
 }
 
 bool MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(MMKPSolution& sol){
+    return MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(sol,this->rng);
+}
+
+bool MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit
+(MMKPSolution& sol, MMKPRandom& rng){
     if(dataSet.isMultiChoiceFeasible(sol)){return true;}
     
     //step 2 from "draft of logic to convert MetaHeuristic Sol...
     for(int i=0;i<sol.size();i++){
         
         int sum = 0;
-        int h1 = 0;   //highest index of all profit
         int h2 = -1;   //highest index of selected profit in row
         
         for(int j=0;j<sol[i].size();j++){
@@ -277,10 +368,6 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(MMKPSolution& sol){
         for(int j=0;j<sol[i].size();j++){
             sum += sol[i][j];
             
-            if(dataSet[i][j].getProfit() >
-               dataSet[i][h1].getProfit()){
-                h1 = j;
-            }
             if((sol[i][j]) && (dataSet[i][j].getProfit() >
                                dataSet[i][h2].getProfit())){
                 assert(h2 != -1);   //if nothing is selected and here, fail.
@@ -292,7 +379,7 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(MMKPSolution& sol){
             continue;
             //choose highest v/[Er%/n]
         }else if(sum == 0){
-            int r = rand() % sol[i].size();
+            int r = rng.nextInt(sol[i].size());
             sol[i][r] = true;
             //choose highest profit of selected items,
             //all others should be unselected
@@ -311,8 +398,12 @@ bool MMKP_MetaHeuristic::makeMultiChoiceFeasMaxProfit(MMKPSolution& sol){
 //ret true if solution is feasible, false otherwise.
 bool MMKP_MetaHeuristic::makeMultiDimFeasFixedSurrogate(MMKPSolution& sol){
     
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
     int iterationCounter = 0;
     
+    //costs are maintained incrementally (swapItem) from here on
+    this->dataSet.updateSolution(sol);
+    
     while(!(this->dataSet.isMultiDimFeasible(sol))){
         std::vector<int> solMaxIndex;
         std::vector<int> minIndex;
@@ -322,7 +413,9 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasFixedSurrogate(MMKPSolution& sol){
             //find max of all selected in a given class
             int localMax = -1;
             float localMaxVal = 0;
-            int localMin = 0;   //default to first item in class
+            //lowest Er%/n leads the candidate list
+            int localMin = flatData.getItemsByUse(i)[0] -
+                flatData.getClassOffset(i);
             for(int j=0;j<sol[i].size();j++){
                 //just check for some off-chance there may
                 //be a negative here at some point.
@@ -334,10 +427,6 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasFixedSurrogate(MMKPSolution& sol){
                     localMax = j;
                     localMaxVal = dataSet[i].at(j).getConstraintUsePercent();
                 }
-                if(dataSet[i].at(j).getConstraintUsePercent() <
-                   dataSet[i].at(localMin).getConstraintUsePercent()){
-                    localMin = j;
-                }
             }
             assert(localMax != -1);
             solMaxIndex.push_back(localMax);
@@ -360,9 +449,8 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasFixedSurrogate(MMKPSolution& sol){
             return false;
         }
         
-        sol[maxDiffIndex][solMaxIndex.at(maxDiffIndex)] = false;
-        sol[maxDiffIndex][minIndex.at(maxDiffIndex)] = true;
-        this->dataSet.updateSolution(sol);
+        this->dataSet.swapItem(sol,maxDiffIndex,solMaxIndex.at(maxDiffIndex),
+                               minIndex.at(maxDiffIndex));
         
         iterationCounter++;
     }
@@ -372,13 +460,18 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasFixedSurrogate(MMKPSolution& sol){
 
 bool MMKP_MetaHeuristic::makeMultiDimFeasVariableSurrogate(MMKPSolution& sol){
     
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
     int currentIterations = 0;
     const int tryFeasibleIter = 3;
     const int maxIterations = (dataSet.getNumberOfResources() * tryFeasibleIter);
     
+    //costs are maintained incrementally (swapItem) from here on
+    this->dataSet.updateSolution(sol);
+    
     while(!(this->dataSet.isMultiDimFeasible(sol))){
         std::vector<int> solMaxIndex;
         std::vector<int> minIndex;
+        std::vector<float> diff;
         std::vector<int> offendingI = this->dataSet.getOffendingIndices(sol);
         
         //find resource using the most above min for all classes
@@ -386,38 +479,45 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVariableSurrogate(MMKPSolution& sol){
             //find max of all selected in a given class
             int localMax = -1;
             float localMaxVal = 0;
-            int localMin = 0;   //default to first item in class
             for(int j=0;j<sol[i].size();j++){
+                if(!sol[i].at(j)){continue;}
+                float use = flatData.getConstraintUsePercent
+                    (flatData.getItemIndex(i,j),offendingI);
                 //just check for some off-chance there may
                 //be a negative here at some point.
                 //in which case this will never be a feasible
                 //pick.
-                assert(dataSet[i].at(j).getConstraintUsePercent(offendingI) >= 0);
-                if((sol[i].at(j)) &&
-                   (dataSet[i].at(j).getConstraintUsePercent(offendingI) >=
-                    localMaxVal)){
-                       localMax = j;
-                       localMaxVal = dataSet[i].at(j)
-                       .getConstraintUsePercent(offendingI);
-                   }
-                if(dataSet[i].at(j).getConstraintUsePercent(offendingI) <
-                   dataSet[i].at(localMin).getConstraintUsePercent(offendingI)){
-                    localMin = j;
+                assert(use >= 0);
+                if(use >= localMaxVal){
+                    localMax = j;
+                    localMaxVal = use;
                 }
             }
             assert(localMax != -1);
+            
+            //a dominated item never uses less than the one dominating it
+            const int* candidates = flatData.getItemsByUse(i);
+            int localMin = candidates[0];
+            float localMinVal = flatData.getConstraintUsePercent(localMin,
+                                                                 offendingI);
+            for(int c=1;c<flatData.getNumberOfCandidates(i);c++){
+                float use = flatData.getConstraintUsePercent(candidates[c],
+                                                             offendingI);
+                if((use < localMinVal) ||
+                   ((use == localMinVal) && (candidates[c] < localMin))){
+                    localMin = candidates[c];
+                    localMinVal = use;
+                }
+            }
             solMaxIndex.push_back(localMax);
-            minIndex.push_back(localMin);
+            minIndex.push_back(localMin - flatData.getClassOffset(i));
+            diff.push_back(localMaxVal - localMinVal);
         }
         
         //replace with min resource item for that class
         bool noDiff = true;
         int maxDiffIndex = 0;
-        std::vector<float> diff(solMaxIndex.size(),0);
         for(int i=0;i<diff.size();i++){
-            diff.at(i) = dataSet[i].at(solMaxIndex.at(i))
-            .getConstraintUsePercent(offendingI)
-            - dataSet[i].at(minIndex.at(i)).getConstraintUsePercent(offendingI);
             if(diff.at(i) > diff.at(maxDiffIndex)){maxDiffIndex = i;}
             if((diff.at(i)) > 0){noDiff = false;}
         }
@@ -426,9 +526,8 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVariableSurrogate(MMKPSolution& sol){
         if(noDiff || (currentIterations == maxIterations)){
             return false;
         }
-        sol[maxDiffIndex][solMaxIndex.at(maxDiffIndex)] = false;
-        sol[maxDiffIndex][minIndex.at(maxDiffIndex)] = true;
-        this->dataSet.updateSolution(sol);
+        this->dataSet.swapItem(sol,maxDiffIndex,solMaxIndex.at(maxDiffIndex),
+                               minIndex.at(maxDiffIndex));
         currentIterations++;
     }
     
@@ -441,6 +540,9 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMinSurrogate(MMKPSolution& sol){
     int lastItem = -1;
     int iterations = 0;
     
+    //costs are maintained incrementally (swapItem) from here on
+    this->dataSet.updateSolution(sol);
+    
     while(!(this->dataSet.isMultiDimFeasible(sol))){
         std::vector<int> selectedIndex(sol.size());
         //find difference for selected values of each class
@@ -477,11 +579,10 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMinSurrogate(MMKPSolution& sol){
             }
         }
         
-        sol[choosenClass][selectedIndex[choosenClass]] = false;
-        sol[choosenClass][choosenItem] = true;
+        this->dataSet.swapItem(sol,choosenClass,selectedIndex[choosenClass],
+                               choosenItem);
         lastClass = choosenClass;
         lastItem = selectedIndex[choosenClass];
-        this->dataSet.updateSolution(sol);
         
         if(iterations == 20){
             return false;
@@ -496,10 +597,14 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMinSurrogate(MMKPSolution& sol){
 
 bool MMKP_MetaHeuristic::makeMultiDimFeasVarMaximizeProfit(MMKPSolution& sol){
     
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
     int lastClass = -1;
     int lastItem = -1;
     int iterations = 0;
     
+    //costs are maintained incrementally (swapItem) from here on
+    this->dataSet.updateSolution(sol);
+    
     while(!(this->dataSet.isMultiDimFeasible(sol))){
         std::vector<int> indices = this->dataSet
         .getOffendingIndices(sol);
@@ -518,18 +623,18 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMaximizeProfit(MMKPSolution& sol){
         int choosenItem = selectedIndex[0];
         float choosenDiff = FLT_MAX;
         
-        //find minimum difference
+        //find minimum difference, over every item of a class since a
+        //dominated item may qualify when the one dominating it does not
         for(int i=0;i<sol.size();i++){
-            float selectedProfit = (this->dataSet[i][selectedIndex[i]]
-                                    .getProfit());
-            float selectedConstrUse = (this->dataSet[i][selectedIndex[i]]
-                                       .getConstraintUsePercent(indices));
+            const int offset = flatData.getClassOffset(i);
+            float selectedProfit = flatData.getProfit(offset+selectedIndex[i]);
+            float selectedConstrUse = flatData.getConstraintUsePercent
+                (offset+selectedIndex[i],indices);
             for(int j=0;j<sol[i].size();j++){
-                float newProfit = this->dataSet[i][j]
-                .getProfit();
+                float newProfit = flatData.getProfit(offset+j);
                 float diff = selectedProfit - newProfit;
-                float newConstrUse = this->dataSet[i][j]
-                .getConstraintUsePercent(indices);
+                float newConstrUse = flatData.getConstraintUsePercent
+                    (offset+j,indices);
                 if((diff > 0)&&(choosenDiff > diff)&&
                    (lastClass != i)&&(lastItem != j)&&
                    (newConstrUse < selectedConstrUse)){
@@ -540,11 +645,10 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMaximizeProfit(MMKPSolution& sol){
             }
         }
         
-        sol[choosenClass][selectedIndex[choosenClass]] = false;
-        sol[choosenClass][choosenItem] = true;
+        this->dataSet.swapItem(sol,choosenClass,selectedIndex[choosenClass],
+                               choosenItem);
         lastClass = choosenClass;
         lastItem = selectedIndex[choosenClass];
-        this->dataSet.updateSolution(sol);
         
         //temporary workaround to handle non-typical data
         if(iterations == 100){
@@ -556,6 +660,198 @@ bool MMKP_MetaHeuristic::makeMultiDimFeasVarMaximizeProfit(MMKPSolution& sol){
     return true;
 }
 
+/**
+ * Candidate swap of one class for makeMultiDimFeasHeapRepair.
+ */
+typedef struct{
+    float score;        //violated Er%/n freed per unit of profit lost
+    int classI;
+    int item;           //item to swap to, -1 if no swap helps
+    int version;        //swaps applied to the class when scored
+    int epoch;          //set of violated resources when scored
+}MMKPRepairCandidate;
+
+/**
+ * Heap order of candidates, the lower class wins a tie.
+ */
+static bool isWorseCandidate(const MMKPRepairCandidate& a,
+                             const MMKPRepairCandidate& b){
+    if(a.score != b.score){
+        return (a.score < b.score);
+    }
+    return (a.classI > b.classI);
+}
+
+/**
+ * Return true if swapping the item with Er% row param: fromRow for the one
+ * with row param: toRow lowers the total over-use, the sum of max(0,C/R-1)
+ * over all resources, by more than rounding. param: usage is C/R of each
+ * resource.
+ */
+static bool isLoweringOverUse(const std::vector<float>& usage,
+                              const float* fromRow, const float* toRow){
+    const float minDrop = 1e-5f;
+    float delta = 0;
+    for(std::size_t k=0;k<usage.size();k++){
+        float after = usage[k] - fromRow[k] + toRow[k];
+        delta += std::max(0.0f,after-1) - std::max(0.0f,usage[k]-1);
+    }
+    return (delta < -minDrop);
+}
+
+/**
+ * Score the best swap away from item param: selected of class param: classI
+ * to an item that is not dominated. Only swaps lowering the total over-use
+ * count, the score is the Er%/n of the violated resources param: offending
+ * freed per unit of profit lost.
+ */
+static MMKPRepairCandidate scoreClass(const MMKPFlatData& flatData, int classI,
+                                      int selected,
+                                      const std::vector<int>& offending,
+                                      const std::vector<float>& usage,
+                                      int version, int epoch){
+    //a swap that gains profit is only limited by this
+    const float minProfitLoss = 1e-6f;
+    
+    MMKPRepairCandidate candidate;
+    candidate.score = -FLT_MAX;
+    candidate.classI = classI;
+    candidate.item = -1;
+    candidate.version = version;
+    candidate.epoch = epoch;
+    
+    const int from = flatData.getItemIndex(classI,selected);
+    const float* fromRow = flatData.getConstraintUsePercentRow(from);
+    const float fromProfit = flatData.getProfit(from);
+    const int* candidates = flatData.getItemsByProfit(classI);
+    for(int c=0;c<flatData.getNumberOfCandidates(classI);c++){
+        const int to = candidates[c];
+        if(to == from){continue;}
+        const float* toRow = flatData.getConstraintUsePercentRow(to);
+        float relief = 0;
+        for(std::size_t k=0;k<offending.size();k++){
+            relief += fromRow[offending[k]] - toRow[offending[k]];
+        }
+        if(relief <= 0){continue;}
+        float loss = std::max(fromProfit-flatData.getProfit(to),minProfitLoss);
+        if(((relief/loss) > candidate.score) &&
+           isLoweringOverUse(usage,fromRow,toRow)){
+            candidate.score = relief/loss;
+            candidate.item = to - flatData.getClassOffset(classI);
+        }
+    }
+    return candidate;
+}
+
+bool MMKP_MetaHeuristic::makeMultiDimFeasHeapRepair(MMKPSolution& sol){
+    
+    const MMKPFlatData& flatData = this->dataSet.getFlatData();
+    const int numberOfClasses = sol.size();
+    const int numberOfResources = flatData.getNumberOfResources();
+    const int numberOfWords = (numberOfResources+63)/64;
+    const int maxIterations = numberOfClasses*std::max(1,numberOfResources);
+    
+    //costs are maintained incrementally (swapItem) from here on
+    this->dataSet.updateSolution(sol);
+    
+    std::vector<uint64_t> violated(numberOfWords+1);
+    std::vector<uint64_t> previous(numberOfWords+1);
+    if(this->dataSet.getViolations(sol,violated.data()) == 0){return true;}
+    
+    const MMKPSolution& items = sol;
+    std::vector<int> selected(numberOfClasses,-1);
+    for(int i=0;i<numberOfClasses;i++){
+        for(int j=0;j<items[i].size();j++){
+            if(items[i][j]){
+                selected[i] = j;
+                break;
+            }
+        }
+    }
+    
+    std::vector<float> usage(numberOfResources);
+    std::vector<int> offending;
+    for(int k=0;k<numberOfResources;k++){
+        usage[k] = sol.getCost(k)/flatData.getResources()[k];
+        if((violated[k/64]>>(k%64)) & 1){offending.push_back(k);}
+    }
+    int epoch = 0;
+    std::vector<int> versions(numberOfClasses,0);
+    std::vector<MMKPRepairCandidate> heap;
+    std::vector<int> blocked;   //classes without a useful swap this epoch
+    for(int i=0;i<numberOfClasses;i++){
+        if(selected[i] < 0){continue;}
+        heap.push_back(scoreClass(flatData,i,selected[i],offending,usage,0,0));
+    }
+    std::make_heap(heap.begin(),heap.end(),isWorseCandidate);
+    
+    int iterations = 0;
+    while(!heap.empty() && (iterations < maxIterations)){
+        std::pop_heap(heap.begin(),heap.end(),isWorseCandidate);
+        MMKPRepairCandidate candidate = heap.back();
+        heap.pop_back();
+        const int i = candidate.classI;
+        
+        //stale, or no longer lowering the over-use since other classes
+        //changed, score again and put it back
+        if((candidate.version != versions[i]) || (candidate.epoch != epoch) ||
+           ((candidate.item >= 0) && !isLoweringOverUse(usage,
+                flatData.getConstraintUsePercentRow
+                (flatData.getItemIndex(i,selected[i])),
+                flatData.getConstraintUsePercentRow
+                (flatData.getItemIndex(i,candidate.item))))){
+            MMKPRepairCandidate rescored = scoreClass(flatData,i,selected[i],
+                                                      offending,usage,
+                                                      versions[i],epoch);
+            if((candidate.version == versions[i]) &&
+               (candidate.epoch == epoch) && (rescored.item < 0)){
+                blocked.push_back(i);
+            }else{
+                heap.push_back(rescored);
+                std::push_heap(heap.begin(),heap.end(),isWorseCandidate);
+            }
+            continue;
+        }
+        if(candidate.item < 0){
+            blocked.push_back(i);
+            continue;
+        }
+        
+        this->dataSet.swapItem(sol,i,selected[i],candidate.item);
+        selected[i] = candidate.item;
+        versions[i]++;
+        iterations++;
+        for(int k=0;k<numberOfResources;k++){
+            usage[k] = sol.getCost(k)/flatData.getResources()[k];
+        }
+        
+        std::copy(violated.begin(),violated.begin()+numberOfWords,
+                  previous.begin());
+        if(this->dataSet.getViolations(sol,violated.data()) == 0){return true;}
+        if(!std::equal(violated.begin(),violated.begin()+numberOfWords,
+                       previous.begin())){
+            //other classes are scored again when they reach the top,
+            //blocked ones may have a useful swap now
+            epoch++;
+            offending.clear();
+            for(int k=0;k<numberOfResources;k++){
+                if((violated[k/64]>>(k%64)) & 1){offending.push_back(k);}
+            }
+            for(std::size_t b=0;b<blocked.size();b++){
+                heap.push_back(scoreClass(flatData,blocked[b],
+                                          selected[blocked[b]],offending,
+                                          usage,versions[blocked[b]],epoch));
+                std::push_heap(heap.begin(),heap.end(),isWorseCandidate);
+            }
+            blocked.clear();
+        }
+        heap.push_back(scoreClass(flatData,i,selected[i],offending,usage,
+                                  versions[i],epoch));
+        std::push_heap(heap.begin(),heap.end(),isWorseCandidate);
+    }
+    return false;
+}
+
 /* OPERATION NOT SUPPORTED */
 OpNotSupported::OpNotSupported(){
     this->message = "Operation not supported.\n";
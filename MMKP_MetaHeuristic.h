@@ -35,6 +35,8 @@
 #define ____MMKP_MetaHeuristic__
 
 #include <iostream>
+#include <string>
+#include <stdlib.h> //atof
 #include <vector>
 #include <time.h>
 #include <cmath>
@@ -46,9 +48,12 @@
 #include <algorithm>
 #include <random>
 #include <tuple>
+#include <chrono>
 
 #include "MMKPSolution.h"
 #include "MMKPDataSet.h"
+#include "MMKPRandom.h"
+#include "MMKPRanking.h"
 
 /**
  * <p>Modification's to regain Multiple Choice Feasibility:
@@ -86,6 +91,9 @@ enum multipleChoiceMod{
  * becuase it attempts to keep a high profit solution.</li>
  * <li>DIM_MIX = Randomly choose between DIM_MAXPROFIT and DIM_VARIABLEMAX</li>
  * <li>DIM_NONE = do nothing</li>
+ * <li>DIM_HEAPREPAIR = Repeatedly apply the item swap that frees the most
+ * violated resources per unit of profit lost, taken from a heap of the
+ * best swap of each class.</li>
  * </lu></p>
  */
 enum multipleDimMod{
@@ -94,12 +102,26 @@ enum multipleDimMod{
     DIM_VARIABLEMIN = 2,
     DIM_MAXPROFIT = 3,
     DIM_MIX = 4,
-    DIM_NONE = 5
+    DIM_NONE = 5,
+    DIM_HEAPREPAIR = 6
 };
 
 /**
  * Parameters for customizing the MetaHeuristic algorithm. Pass as an 
- * argument to constructor of type MMKP_MetaHeuristic.
+ * argument to constructor of type MMKP_MetaHeuristic. A seed of 0 seeds
+ * the heuristic's generator from std::random_device, so runs differ.
+ *
+ * <p>Besides numberOfGenerations (negative = no limit) a run stops at the
+ * first of these budgets reached, each is off when 0:
+ * <lu>
+ * <li>timeLimit = wall clock seconds since the start of run.</li>
+ * <li>maxFuncEvals = function evaluations.</li>
+ * <li>targetProfit = a feasible solution with at least this profit.</li>
+ * <li>maxStagnantGenerations = generations in a row without a better
+ * feasible solution.</li>
+ * </lu>
+ * Time and evaluation budgets are also checked inside a generation, so run
+ * returns the best solution found so far shortly after they expire.</p>
  */
 class MetaHeuristic_parameters{
 public:
@@ -107,12 +129,36 @@ public:
     int numberOfGenerations;
     int multipleChoiceFeasibilityMod;
     int multipleDimFeasibilityMod;
+    unsigned long long seed;
+    double timeLimit;
+    int maxFuncEvals;
+    float targetProfit;
+    int maxStagnantGenerations;
     
     MetaHeuristic_parameters(){
         this->numberOfGenerations = 60;
         this->multipleChoiceFeasibilityMod = 2;
         this->multipleDimFeasibilityMod = 1;
+        this->seed = 0;
+        this->timeLimit = 0;
+        this->maxFuncEvals = 0;
+        this->targetProfit = 0;
+        this->maxStagnantGenerations = 0;
     }
+    
+    /**
+     * Set the budget given by param: option, one of time=<seconds>,
+     * evals=<function evaluations>, target=<profit> or
+     * stagnation=<generations> (ex. from the command line). Return false,
+     * changing nothing, if param: option is not one of them.
+     */
+    bool parseBudget(const std::string& option);
+    
+    /**
+     * Take the budgets (timeLimit, maxFuncEvals, targetProfit and
+     * maxStagnantGenerations) of param: budgets.
+     */
+    void setBudgets(const MetaHeuristic_parameters& budgets);
 };
 
 /**
@@ -128,6 +174,31 @@ protected:
     int currentFuncEvals;
     int convergenceIteration;
     int currentGeneration;
+    MMKPRandom rng;
+    std::chrono::steady_clock::time_point startTime;
+    float stagnantProfit;
+    int stagnantGenerations;
+    int lastCheckedGeneration;
+    
+    /**
+     * Start the budgets of a run (see MetaHeuristic_parameters), call at
+     * the start of run.
+     */
+    void startBudget();
+    
+    /**
+     * Return true if the time or function evaluation budget is used up.
+     * Cheap enough to call once per solution inside a generation.
+     */
+    bool isBudgetExhausted() const;
+    
+    /**
+     * Return true if a run should stop after generation param: generation,
+     * having found best feasible profit param: bestProfit so far. Checks
+     * numberOfGenerations and every budget. Calls with the same generation
+     * (ex. once per offspring) count toward stagnation only once.
+     */
+    bool isTerminated(int generation, float bestProfit);
     
     /*
      * Update solution based on 'competetive strategy'. A feasible
@@ -144,11 +215,6 @@ protected:
      */
     void addToUniqueSolutionSet(MMKPSolution sol);
     
-    /**
-     * Quicksort helper funtion.
-     */
-    int partition(std::vector<MMKPSolution>& input,int p, int r);
-
 public:
     /**
      * Construct MMKP_MetaHeuristic object. Param: parameters can customize
@@ -180,14 +246,31 @@ public:
     
     int getConvergenceGeneration();
     
+    /**
+     * Return the function evaluations counted so far, since the start of
+     * the last run (or construction) and including runOneGeneration calls.
+     */
+    int getFuncEvals();
+    
+    //mutator
+    /**
+     * Replace the heuristic's generator with param: rng, ex. a stream split
+     * from the generator of a heuristic running this one.
+     */
+    void setRandom(const MMKPRandom& rng);
+    
     //other
     /**
-     * Sort a population of MMKPSolution's using quicksort. Param p is
-     * the starting array element and r is the last. Note that r is not
-     * equal to the size of input, but the index of the last element to
-     * be sorted (in most cases size-1).
+     * Sort a population of MMKPSolution's by profit, greatest first (see
+     * MMKPRanking). Solutions are swapped into place, never copied.
+     */
+    void sortPopulation(std::vector<MMKPSolution>& population);
+    
+    /**
+     * Move the best param: k solutions of param: population to its front,
+     * greatest profit first. The order of the rest is unspecified.
      */
-    void quickSort(std::vector<MMKPSolution>& input,int p, int r);
+    void sortPopulationTop(std::vector<MMKPSolution>& population, int k);
     
     /**
      * Run metaheuristic and return the result, the best objective
@@ -213,6 +296,13 @@ public:
      */
     bool makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas);
     
+    /**
+     * Wrapper function of both feasiblity routines. Random choices are
+     * taken from param: rng instead of the heuristic's own generator, ex.
+     * a stream owned by one thread.
+     */
+    bool makeFeasible(MMKPSolution& sol,int mcFeas,int mdFeas,MMKPRandom& rng);
+    
     /**
      * Make multi-choice feasible based on a surrogate constraint
      * created using all costs of an item. If one item of a class
@@ -234,6 +324,13 @@ public:
      */
     bool makeMultiChoiceFeasFixed_Rand_Surrogate(MMKPSolution& sol);
     
+    /**
+     * makeMultiChoiceFeasFixed_Rand_Surrogate taking random choices from
+     * param: rng.
+     */
+    bool makeMultiChoiceFeasFixed_Rand_Surrogate(MMKPSolution& sol,
+                                                 MMKPRandom& rng);
+    
     /**
      * Make multi-choice feasible based on profit alone.
      * If one item of a class is selected, continue, else if
@@ -243,6 +340,11 @@ public:
      */
     bool makeMultiChoiceFeasMaxProfit(MMKPSolution& sol);
     
+    /**
+     * makeMultiChoiceFeasMaxProfit taking random choices from param: rng.
+     */
+    bool makeMultiChoiceFeasMaxProfit(MMKPSolution& sol, MMKPRandom& rng);
+    
     /**
      * Make multi-dim feasible based a surrogate constraint
      * created using all costs in an item. Feasibility is
@@ -291,6 +393,21 @@ public:
      *      otherwise.
      */
     bool makeMultiDimFeasVarMaximizeProfit(MMKPSolution& sol);
+    
+    /**
+     * Make multi-dim feasible by a heap of candidate swaps, one per class:
+     * the item whose swap frees the most of the violated resources
+     * (Er%/n over the violated constraints) per unit of profit lost.
+     * The best swap is applied and only its class is scored again. When
+     * the set of violated resources changes, the other candidates are
+     * scored again as they reach the top of the heap. Return's true if
+     * successful, false otherwise.
+     *
+     * Precondition: there must only be one item of each
+     *      class selected, correctness is not garenteed
+     *      otherwise.
+     */
+    bool makeMultiDimFeasHeapRepair(MMKPSolution& sol);
 };
 
 /**
@@ -35,6 +35,7 @@ MMKPSolution MMKP_PSO::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     this->currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
     MMKPSolution bestSolution;
     bestSolution.setProfit(0);
@@ -55,7 +56,7 @@ MMKPSolution MMKP_PSO::run(std::vector<MMKPSolution> initialPopulation){
         for(int j=0;j<temp.solution.size();j++){
             std::vector<float> tempV;
             for(int k=0;k<temp.solution[j].size();k++){
-                float v = (rand() % 4) - 2;
+                float v = this->rng.nextInt(4) - 2;
                 tempV.push_back(v);
             }
             temp.v.push_back(tempV);
@@ -75,7 +76,8 @@ MMKPSolution MMKP_PSO::run(std::vector<MMKPSolution> initialPopulation){
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= (this->parameters.numberOfGenerations)){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         
@@ -95,11 +97,10 @@ std::vector<MMKPSolution> MMKP_PSO::runOneGeneration
 
 void MMKP_PSO::particleUpdate(std::vector<Particle>& particles,MMKPSolution& bestSolution){
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> dib(0, 1);
     
     for(int i=0;i<particles.size();i++){
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
 
         MMKPSolution oldSolution = particles[i].solution;
         
@@ -123,7 +124,7 @@ void MMKP_PSO::particleUpdate(std::vector<Particle>& particles,MMKPSolution& bes
                 }
 
                 float normalizedV = 1/(1+(exp(-(particles[i].v[j][k]))));
-                float r = dib(gen);
+                float r = dib(this->rng);
                 
                 //update position
                 if(r <= normalizedV){
@@ -17,6 +17,9 @@
 //constructors
 MMKP_TLBO::MMKP_TLBO(MMKPDataSet dataSet, TLBO_parameters parameters)
 :MMKP_MetaHeuristic(dataSet,parameters),parameters(parameters){
+    if(this->parameters.numberOfThreads != 1){
+        this->pool.reset(new ThreadPool(this->parameters.numberOfThreads));
+    }
 }
 
 MMKP_TLBO::MMKP_TLBO(MMKPDataSet dataSet)
@@ -36,6 +39,7 @@ MMKPSolution MMKP_TLBO::run(std::vector<MMKPSolution> initialPopulation){
     this->convergenceData.empty();
     this->convergenceIteration = 0;
     currentFuncEvals = 0;
+    MMKP_MetaHeuristic::startBudget();
     
     MMKPSolution bestSolution;
     for(int i=0;i<population.size();i++){
@@ -50,7 +54,7 @@ MMKPSolution MMKP_TLBO::run(std::vector<MMKPSolution> initialPopulation){
     std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
     this->convergenceData.push_back(temp);
     
-    MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
+    MMKP_MetaHeuristic::sortPopulation(population);
     
     //main loop
     while(!terminationCriterion){
@@ -70,7 +74,7 @@ MMKPSolution MMKP_TLBO::run(std::vector<MMKPSolution> initialPopulation){
             throw OpNotSupported(("Teaching Phase ID not recognized.\n"));
         }
         
-        MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
+        MMKP_MetaHeuristic::sortPopulation(population);
         
         for(int i=0;i<population.size();i++){
             if(this->dataSet.isFeasible(population[i])){
@@ -84,7 +88,8 @@ MMKPSolution MMKP_TLBO::run(std::vector<MMKPSolution> initialPopulation){
         std::tuple<int,float> temp(currentFuncEvals,bestSolution.getProfit());
         this->convergenceData.push_back(temp);
         
-        if(currentGeneration >= (this->parameters.numberOfGenerations)){
+        if(MMKP_MetaHeuristic::isTerminated(currentGeneration,
+                                            bestSolution.getProfit())){
             terminationCriterion = true;
         }
         currentGeneration++;
@@ -96,7 +101,7 @@ MMKPSolution MMKP_TLBO::run(std::vector<MMKPSolution> initialPopulation){
 std::vector<MMKPSolution> MMKP_TLBO::runOneGeneration
 (std::vector<MMKPSolution> population){
     
-    MMKP_MetaHeuristic::quickSort(population,0,(population.size()-1));
+    MMKP_MetaHeuristic::sortPopulation(population);
     
     if(this->parameters.alg_Type == 0){
         MMKP_TLBO::teachingPhase(population);
@@ -117,43 +122,131 @@ std::vector<MMKPSolution> MMKP_TLBO::runOneGeneration
     return population;
 }
 
+void MMKP_TLBO::updateLearners(std::vector<MMKPSolution>& population,
+                               const std::vector<int>& learners,
+                               const TLBO_candidate& candidate){
+    if(!this->pool){
+        //sequential, each learner sees the updates of those before it
+        for(std::size_t k=0;k<learners.size();k++){
+            if(MMKP_MetaHeuristic::isBudgetExhausted()){break;}
+            MMKPSolution* currentSol = &population[learners[k]];
+            MMKPSolution tempSol = *currentSol;
+            int funcEvals = 0;
+            if(!candidate(learners[k],tempSol,this->rng,funcEvals)){continue;}
+            this->currentFuncEvals += funcEvals;
+            
+            dataSet.updateSolution(tempSol);
+            MMKP_MetaHeuristic::makeFeasible(tempSol);
+            MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
+        }
+        return;
+    }
+    
+    //parallel, all candidates are built from the population as it is now,
+    //each with its own stream, and then committed in learner order.
+    std::vector<MMKPRandom> streams(learners.size());
+    for(std::size_t k=0;k<learners.size();k++){
+        streams[k] = this->rng.split();
+    }
+    std::vector<MMKPSolution> candidates(learners.size());
+    std::vector<char> isCandidate(learners.size(),0);
+    std::vector<int> funcEvals(learners.size(),0);
+    
+    this->pool->parallelFor(learners.size(),[&](int k){
+        if(MMKP_MetaHeuristic::isBudgetExhausted()){return;}
+        candidates[k] = population[learners[k]];
+        isCandidate[k] = candidate(learners[k],candidates[k],streams[k],funcEvals[k]);
+        if(isCandidate[k]){
+            dataSet.updateSolution(candidates[k]);
+            MMKP_MetaHeuristic::makeFeasible(candidates[k],
+                                    this->parameters.multipleChoiceFeasibilityMod,
+                                    this->parameters.multipleDimFeasibilityMod,
+                                    streams[k]);
+        }
+    });
+    
+    for(std::size_t k=0;k<learners.size();k++){
+        if(!isCandidate[k]){continue;}
+        this->currentFuncEvals += funcEvals[k];
+        MMKP_MetaHeuristic::competitiveUpdateSol(population[learners[k]],
+                                                 candidates[k]);
+    }
+}
+
+/**
+ * Teacher update of param: learner into tempSol, a word of items at a time.
+ * Each bit becomes ceil(x + r*(t - T_f*m)) > 0, for r in {0,1} and T_f in
+ * {1,2} drawn per bit from one random word each. For i-tlbo param: other
+ * is not NULL and x - o (param: isBetter) or o - x is added. Return the
+ * number of bits updated.
+ */
+static int teachLearner(const MMKPSolution& learner, const MMKPSolution& teacher,
+                        const MMKPSolution& mean, const MMKPSolution* other,
+                        bool isBetter, MMKPSolution& tempSol, MMKPRandom& rng){
+    MMKPBitSolution x(learner);
+    MMKPBitSolution t(teacher);
+    MMKPBitSolution m(mean);
+    MMKPBitSolution o;
+    if(other != NULL){
+        o.fromSolution(*other);
+    }
+    
+    MMKPBitSolution result(x.size());
+    for(int w=0;w<x.getNumberOfWords();w++){
+        const uint64_t X = x.getWord(w);
+        const uint64_t T = t.getWord(w);
+        const uint64_t M = m.getWord(w);
+        const uint64_t R = rng();   //r = 1
+        const uint64_t F = rng();   //T_f = 1
+        
+        //bits with r = 1 and r = 0, worked out from the truth table
+        uint64_t taught, kept;
+        if(other == NULL){
+            taught = ((X | T) & ~M) | (F & X & T);
+            kept = X;
+        }else if(isBetter){
+            const uint64_t O = o.getWord(w);
+            taught = (X & ((F & ~(~T & M & O)) | (~F & (~M | (T & ~O))))) |
+                (~X & T & ~M & ~O);
+            kept = X;
+        }else{
+            const uint64_t O = o.getWord(w);
+            taught = (~M & (T | O)) | (F & T & O);
+            kept = O;
+        }
+        result.setWord(w,(R & taught) | (~R & kept));
+    }
+    result.toSolution(tempSol);
+    return x.size();
+}
+
 void MMKP_TLBO::teachingPhase(std::vector<MMKPSolution>& population){
     int teacherIndex = 0;
     
-    MMKPSolution* teacher = &population[teacherIndex];
-    MMKPSolution* mean = &population[(population.size()/2)];
-    
     if(this->parameters.rls_on == 1){
-        ReactiveLocalSearch RLS(dataSet);
-        *teacher = RLS(*teacher);
+        ReactiveLocalSearch RLS(dataSet,this->rng.split());
+        population[teacherIndex] = RLS(population[teacherIndex]);
         this->currentFuncEvals += RLS.getFuncEvals();
     }
     
+    //learners are built in parallel, only read shared solutions as const
+    const MMKPSolution* teacher = &population[teacherIndex];
+    const MMKPSolution* mean = &population[(population.size()/2)];
+    
+    std::vector<int> learners;
     for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        if(currentSol == teacher){continue;}
-        
-        //step 1: convert bits with -2,-1 to 0, and 1 otherwise
-        for(int j=0;j<(*currentSol).size();j++){
-            for(int k=0;k<(*currentSol)[j].size();k++){
-                int T_f = rand()%2+1;
-                int r = rand()%2;
-                int diff = ceil((*currentSol)[j].at(k)+(r*((*teacher)[j].at(k)
-                                    - (T_f * (*mean)[j].at(k)))));
-                if(diff<=0){
-                    (tempSol)[j].at(k) = false;
-                }else{
-                    (tempSol)[j].at(k) = true;
-                }
-                this->currentFuncEvals++;
-            }
-        }
-        
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
+        if(i != teacherIndex){learners.push_back(i);}
     }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        //step 1: convert bits with -2,-1 to 0, and 1 otherwise
+        funcEvals += teachLearner(population[i],*teacher,*mean,NULL,false,
+                                  tempSol,rng);
+        return true;
+    });
 }
 
 void MMKP_TLBO::teachingPhase_MultiTeacherEvenDist(std::vector<MMKPSolution>& population,
@@ -170,52 +263,24 @@ void MMKP_TLBO::teachingPhase_MultiTeacherEvenDist(std::vector<MMKPSolution>& po
         stop = this->parameters.populationSize - 1;
     }
     
+    //group (teacher, mean and range) of each learner
+    std::vector<int> learners;
+    std::vector<int> groupStart(population.size());
+    std::vector<int> groupStop(population.size());
+    
     while((start < stop) && (stop < this->parameters.populationSize)){
         
-        MMKPSolution* teacher = &population[start];
         if(this->parameters.rls_on == 1){
-            ReactiveLocalSearch RLS(dataSet);
-            *teacher = RLS(*teacher);
+            ReactiveLocalSearch RLS(dataSet,this->rng.split());
+            population[start] = RLS(population[start]);
             this->currentFuncEvals += RLS.getFuncEvals();
         }
         
-        MMKPSolution* mean = &population[((start+stop)/2)];
-        
-        for(int i=start;i<stop;i++){
-            
-            MMKPSolution* currentSol = &population[i];
-            MMKPSolution tempSol = *currentSol;
-            if(currentSol == teacher){continue;}
-            //r_i is the random learnin to effect i-tlbo
-            int r_i = rand() % (stop-start)+start;
-            
-            //step 1: convert bits with -2,-1 to 0, and 1 otherwise
-            for(int j=0;j<(*currentSol).size();j++){
-                for(int k=0;k<(*currentSol)[j].size();k++){
-                    int T_f = rand()%2+1;
-                    int r = rand()%2;   //r, not used in Vasko et al.
-                    int diff = ((*currentSol)[j].at(k)+(r*((*teacher)[j].at(k)
-                                                - (T_f * (*mean)[j].at(k)))));
-                    //i-tlbo addition to difference mean
-                    if((*currentSol).getProfit() > population[r_i].getProfit()){
-                        diff += (*currentSol)[j].at(k) - population[r_i][j].at(k);
-                    }else{
-                        diff += population[r_i][j].at(k) - (*currentSol)[j].at(k);
-                    }
-                    
-                    if(diff<=0){
-                        (tempSol)[j].at(k) = false;
-                    }else{
-                        (tempSol)[j].at(k) = true;
-                    }
-                    this->currentFuncEvals++;
-                }
-            }
-            dataSet.updateSolution(tempSol);
-            MMKP_MetaHeuristic::makeFeasible(tempSol);
-            MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-            
-        }//end for(int i...
+        for(int i=start+1;i<stop;i++){
+            learners.push_back(i);
+            groupStart[i] = start;
+            groupStop[i] = stop;
+        }
         
         //update start and stop
         start += classSize;
@@ -226,6 +291,26 @@ void MMKP_TLBO::teachingPhase_MultiTeacherEvenDist(std::vector<MMKPSolution>& po
         }
         
     }//end while(stop....
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        int start = groupStart[i];
+        int stop = groupStop[i];
+        const MMKPSolution* teacher = &population[start];
+        const MMKPSolution* mean = &population[((start+stop)/2)];
+        const MMKPSolution* currentSol = &population[i];
+        //r_i is the random learnin to effect i-tlbo
+        int r_i = rng.nextInt(stop-start)+start;
+        
+        //step 1: convert bits with -2,-1 to 0, and 1 otherwise, with the
+        //i-tlbo addition to difference mean
+        funcEvals += teachLearner(*currentSol,*teacher,*mean,&population[r_i],
+                                  ((*currentSol).getProfit() >
+                                   population[r_i].getProfit()),tempSol,rng);
+        return true;
+    });
 }
 
 void MMKP_TLBO::teachingPhase_Modified(std::vector<MMKPSolution>& population,
@@ -234,9 +319,14 @@ void MMKP_TLBO::teachingPhase_Modified(std::vector<MMKPSolution>& population,
     std::priority_queue<int,std::vector<int>,std::greater<int> > pq;
     pq.push(0);
     for(int i=0;i<numberOfTeachers-1;i++){
-        pq.push((rand() % population.size()));
+        pq.push(this->rng.nextInt(population.size()));
     }
     
+    //group (teacher and mean) of each learner
+    std::vector<int> learners;
+    std::vector<int> groupStart(population.size());
+    std::vector<int> groupStop(population.size());
+    
     while(!pq.empty()){
         
         int start = pq.top();
@@ -248,44 +338,31 @@ void MMKP_TLBO::teachingPhase_Modified(std::vector<MMKPSolution>& population,
             stop = population.size();
         }
         
-        MMKPSolution* teacher = &population[start];
         if(this->parameters.rls_on == 1){
-            ReactiveLocalSearch RLS(dataSet);
-            *teacher = RLS(*teacher);
+            ReactiveLocalSearch RLS(dataSet,this->rng.split());
+            population[start] = RLS(population[start]);
             this->currentFuncEvals += RLS.getFuncEvals();
         }
         
-        MMKPSolution* mean = &population[((start+stop)/2)];
-        
-        for(int i=start;i<stop;i++){
-            
-            MMKPSolution* currentSol = &population[i];
-            MMKPSolution tempSol = *currentSol;
-            if(currentSol == teacher){continue;}
-            
-            //step 1: convert bits with -2,-1 to 0, and 1 otherwise
-            for(int j=0;j<(*currentSol).size();j++){
-                for(int k=0;k<(*currentSol)[j].size();k++){
-                    int T_f = rand()%2+1;
-                    int r = rand()%2;   //r, not used in Vasko et al.
-                    int diff = ((*currentSol)[j].at(k)+(r*((*teacher)[j].at(k)
-                                                        - (T_f * (*mean)[j].at(k)))));
-                    
-                    if(diff<=0){
-                        (tempSol)[j].at(k) = false;
-                    }else{
-                        (tempSol)[j].at(k) = true;
-                    }
-                    this->currentFuncEvals++;
-                }
-            }
-            dataSet.updateSolution(tempSol);
-            MMKP_MetaHeuristic::makeFeasible(tempSol);
-            MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-            
+        for(int i=start+1;i<stop;i++){
+            learners.push_back(i);
+            groupStart[i] = start;
+            groupStop[i] = stop;
         }
         
     }//end while(stop....
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* teacher = &population[groupStart[i]];
+        const MMKPSolution* mean = &population[((groupStart[i]+groupStop[i])/2)];
+        //step 1: convert bits with -2,-1 to 0, and 1 otherwise
+        funcEvals += teachLearner(population[i],*teacher,*mean,NULL,false,
+                                  tempSol,rng);
+        return true;
+    });
 }
 
 void MMKP_TLBO::teachingPhase_MultiTeacher(std::vector<MMKPSolution>& population,
@@ -294,9 +371,14 @@ void MMKP_TLBO::teachingPhase_MultiTeacher(std::vector<MMKPSolution>& population
     std::priority_queue<int,std::vector<int>,std::greater<int> > pq;
     pq.push(0);
     for(int i=0;i<numberOfTeachers-1;i++){
-        pq.push((rand() % population.size()));
+        pq.push(this->rng.nextInt(population.size()));
     }
     
+    //group (teacher, mean and range) of each learner
+    std::vector<int> learners;
+    std::vector<int> groupStart(population.size());
+    std::vector<int> groupStop(population.size());
+    
     while(!pq.empty()){
         
         int start = pq.top();
@@ -308,79 +390,72 @@ void MMKP_TLBO::teachingPhase_MultiTeacher(std::vector<MMKPSolution>& population
             stop = population.size();
         }
         
-        MMKPSolution* teacher = &population[start];
         if(this->parameters.rls_on == 1){
-            ReactiveLocalSearch RLS(dataSet);
-            *teacher = RLS(*teacher);
+            ReactiveLocalSearch RLS(dataSet,this->rng.split());
+            population[start] = RLS(population[start]);
             this->currentFuncEvals += RLS.getFuncEvals();
         }
         
-        MMKPSolution* mean = &population[((start+stop)/2)];
-        
-        for(int i=start;i<stop;i++){
-            
-            MMKPSolution* currentSol = &population[i];
-            MMKPSolution tempSol = *currentSol;
-            if(currentSol == teacher){continue;}
-            //r_i is the random learnin to effect i-tlbo
-            int r_i = rand() % (stop-start)+start;
-            
-            //step 1: convert bits with -2,-1 to 0, and 1 otherwise
-            for(int j=0;j<(*currentSol).size();j++){
-                for(int k=0;k<(*currentSol)[j].size();k++){
-                    int T_f = rand()%2+1;
-                    int r = rand()%2;   //r, not used in Vasko et al.
-                    int diff = ((*currentSol)[j].at(k)+(r*((*teacher)[j].at(k)
-                                                        - (T_f * (*mean)[j].at(k)))));
-                    //i-tlbo addition to difference mean
-                    if((*currentSol).getProfit() > population[r_i].getProfit()){
-                        diff += (*currentSol)[j].at(k) - population[r_i][j].at(k);
-                    }else{
-                        diff += population[r_i][j].at(k) - (*currentSol)[j].at(k);
-                    }
-                    
-                    if(diff<=0){
-                        (tempSol)[j].at(k) = false;
-                    }else{
-                        (tempSol)[j].at(k) = true;
-                    }
-                    this->currentFuncEvals++;
-                }
-            }
-            dataSet.updateSolution(tempSol);
-            MMKP_MetaHeuristic::makeFeasible(tempSol);
-            MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-            
+        for(int i=start+1;i<stop;i++){
+            learners.push_back(i);
+            groupStart[i] = start;
+            groupStop[i] = stop;
         }
         
     }//end while(stop....
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        int start = groupStart[i];
+        int stop = groupStop[i];
+        const MMKPSolution* teacher = &population[start];
+        const MMKPSolution* mean = &population[((start+stop)/2)];
+        const MMKPSolution* currentSol = &population[i];
+        //r_i is the random learnin to effect i-tlbo
+        int r_i = rng.nextInt(stop-start)+start;
+        
+        //step 1: convert bits with -2,-1 to 0, and 1 otherwise, with the
+        //i-tlbo addition to difference mean
+        funcEvals += teachLearner(*currentSol,*teacher,*mean,&population[r_i],
+                                  ((*currentSol).getProfit() >
+                                   population[r_i].getProfit()),tempSol,rng);
+        return true;
+    });
 }
 
 void MMKP_TLBO::teachingPhase_Orthognal(std::vector<MMKPSolution>& population,
                              int iteration){
-    MMKPSolution* teacher = &population[0];
     if(this->parameters.rls_on == 1){
-        ReactiveLocalSearch RLS(dataSet);
-        *teacher = RLS(*teacher);
+        ReactiveLocalSearch RLS(dataSet,this->rng.split());
+        population[0] = RLS(population[0]);
         this->currentFuncEvals += RLS.getFuncEvals();
     }
     
-    MMKPSolution* mean = &population[(population.size()/2)];
+    const MMKPSolution* teacher = &population[0];
+    const MMKPSolution* mean = &population[(population.size()/2)];
     
     float wMax = 1.0;
     float wMin = .5;
     float weight = wMax -
         (((wMax - wMin)/parameters.numberOfGenerations) * iteration);
     
-    for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        if(currentSol == teacher){continue;}
+    std::vector<int> learners;
+    for(int i=1;i<population.size();i++){
+        learners.push_back(i);
+    }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
         
         //step 1: convert bits with -2,-1 to 0, and 1 otherwise
         for(int j=0;j<(*currentSol).size();j++){
             for(int k=0;k<(*currentSol)[j].size();k++){
-                int T_f = rand()%2+1;
+                int T_f = rng.nextInt(2)+1;
                 int diff = ceil(weight*((*currentSol)[j].at(k)+((*teacher)[j].at(k)
                                                         - (T_f * (*mean)[j].at(k)))));
                 if(diff<=0){
@@ -388,33 +463,39 @@ void MMKP_TLBO::teachingPhase_Orthognal(std::vector<MMKPSolution>& population,
                 }else{
                     (tempSol)[j].at(k) = true;
                 }
+                funcEvals++;
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
 }
 
 void MMKP_TLBO::learningPhase(std::vector<MMKPSolution>& population){
     
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
     
+    std::vector<int> learners;
     for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        int randSol = rand() % population.size();
-        MMKPSolution* otherSol = &population[randSol];
+        learners.push_back(i);
+    }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
+        int randSol = rng.nextInt(population.size());
+        const MMKPSolution* otherSol = &population[randSol];
         
         //if they are the same, skip
-        if(currentSol == otherSol){continue;}
+        if(currentSol == otherSol){return false;}
         
         //if P_k costs less than P_i
         if((*otherSol).getProfit() > (*currentSol).getProfit()){
             //then P_new = P_i+r(P_k-P_i)
                 for(int j=0;j<(*currentSol).size();j++){
                     for(int k=0;k<(*currentSol)[j].size();k++){
-                        int r = rand()%2;
+                        int r = rng.nextInt(2);
                         int diff = ceil((*currentSol)[j].at(k)+
                                     (r*((*otherSol)[j].at(k)-(*currentSol)[j].at(k))));
                         if(diff<=0){
@@ -422,7 +503,7 @@ void MMKP_TLBO::learningPhase(std::vector<MMKPSolution>& population){
                         }else{
                             (tempSol)[j].at(k) = true;
                         }
-                        this->currentFuncEvals++;
+                        funcEvals++;
                     }
                 }
         //else
@@ -430,7 +511,7 @@ void MMKP_TLBO::learningPhase(std::vector<MMKPSolution>& population){
             //then P_new = P_i+r(P_i-P_k)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil((*currentSol)[j].at(k)+
                                 (r*((*currentSol)[j].at(k)-(*otherSol)[j].at(k))));
                     if(diff<=0){
@@ -438,44 +519,50 @@ void MMKP_TLBO::learningPhase(std::vector<MMKPSolution>& population){
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
-                    this->currentFuncEvals++;
+                    funcEvals++;
                 }
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
 }
 
 void MMKP_TLBO::improvedLearningPhase(std::vector<MMKPSolution>& population){
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
     
+    std::vector<int> learners;
     for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        int randSol = rand() % population.size();
-        MMKPSolution* otherSol = &population[randSol];
+        learners.push_back(i);
+    }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
+        int randSol = rng.nextInt(population.size());
+        const MMKPSolution* otherSol = &population[randSol];
+        const MMKPSolution* best = &population[0];
         
         //if they are the same, skip
-        if(currentSol == otherSol){continue;}
+        if(currentSol == otherSol){return false;}
         
         //if P_k costs less than P_i
         if((*otherSol).getProfit() > (*currentSol).getProfit()){
             //then P_new = P_i+r(P_k-P_i)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil((*currentSol)[j].at(k)+
                                     (r*((*otherSol)[j].at(k)-(*currentSol)[j].at(k))));
                     //i-tlbo addition
-                    int selfLearning = population[0][j].at(k)
-                        -(1+(rand()%2)*(*currentSol)[j].at(k));
+                    int selfLearning = (*best)[j].at(k)
+                        -(1+(rng.nextInt(2))*(*currentSol)[j].at(k));
                     
                     if (selfLearning < 0){
-                        diff -= (rand() % abs(selfLearning));
+                        diff -= (rng.nextInt(abs(selfLearning)));
                     }else if( selfLearning > 0){
-                        diff += (rand() % abs(selfLearning));
+                        diff += (rng.nextInt(abs(selfLearning)));
                     }
                     
                     if(diff<=0){
@@ -483,7 +570,7 @@ void MMKP_TLBO::improvedLearningPhase(std::vector<MMKPSolution>& population){
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
-                    this->currentFuncEvals++;
+                    funcEvals++;
                 }
             }
             //else
@@ -491,17 +578,17 @@ void MMKP_TLBO::improvedLearningPhase(std::vector<MMKPSolution>& population){
             //then P_new = P_i+r(P_i-P_k)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil((*currentSol)[j].at(k)+
                                     (r*((*currentSol)[j].at(k)-(*otherSol)[j].at(k))));
                     //i-tlbo addition
-                    int selfLearning = population[0][j].at(k)
-                    -(1+(rand()%2)*(*currentSol)[j].at(k));
+                    int selfLearning = (*best)[j].at(k)
+                    -(1+(rng.nextInt(2))*(*currentSol)[j].at(k));
                     
                     if (selfLearning < 0){
-                        diff -= (rand() % abs(selfLearning));
+                        diff -= (rng.nextInt(abs(selfLearning)));
                     }else if( selfLearning > 0){
-                        diff += (rand() % abs(selfLearning));
+                        diff += (rng.nextInt(abs(selfLearning)));
                     }
                     
                     if(diff<=0){
@@ -509,35 +596,40 @@ void MMKP_TLBO::improvedLearningPhase(std::vector<MMKPSolution>& population){
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
-                    this->currentFuncEvals++;
+                    funcEvals++;
                 }
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
 }
 
 void MMKP_TLBO::modifiedLearningPhase(std::vector<MMKPSolution>& population){
     
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
     
+    std::vector<int> learners;
     for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        int randSol = rand() % population.size();
-        MMKPSolution* otherSol = &population[randSol];
+        learners.push_back(i);
+    }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
+        int randSol = rng.nextInt(population.size());
+        const MMKPSolution* otherSol = &population[randSol];
         
         //if they are the same, skip
-        if(currentSol == otherSol){continue;}
+        if(currentSol == otherSol){return false;}
         
         //if P_k costs less than P_i
         if((*otherSol).getProfit() > (*currentSol).getProfit()){
             //then P_new = P_i+r(P_k-P_i)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil((*currentSol)[j].at(k)+
                                     (r*((*otherSol)[j].at(k)-(*currentSol)[j].at(k))));
                     if(diff<=0){
@@ -545,7 +637,7 @@ void MMKP_TLBO::modifiedLearningPhase(std::vector<MMKPSolution>& population){
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
-                    this->currentFuncEvals++;
+                    funcEvals++;
                 }
             }
             //else
@@ -553,7 +645,7 @@ void MMKP_TLBO::modifiedLearningPhase(std::vector<MMKPSolution>& population){
             //then P_new = P_i+r(P_i-P_k)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil((*currentSol)[j].at(k)+
                                     (r*((*currentSol)[j].at(k)-(*otherSol)[j].at(k))));
                     if(diff<=0){
@@ -561,64 +653,68 @@ void MMKP_TLBO::modifiedLearningPhase(std::vector<MMKPSolution>& population){
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
-                    this->currentFuncEvals++;
+                    funcEvals++;
                 }
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
     
     //self motivated learning
-    for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
 
         for(int j=0;j<(*currentSol).size();j++){
             for(int k=0;k<(*currentSol)[j].size();k++){
-                int r = rand()%2;
+                int r = rng.nextInt(2);
                 int diff = ((*currentSol)[j].at(k)+r);
                 if(diff<=0){
                     (tempSol)[j].at(k) = false;
                 }else{
                     (tempSol)[j].at(k) = true;
                 }
-                this->currentFuncEvals++;
+                funcEvals++;
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
 }
 
 void MMKP_TLBO::learningPhase_Orthognal(std::vector<MMKPSolution>& population,
                              int iteration){
     
-    quickSort(population,0,(population.size()-1));
+    sortPopulation(population);
     
     float wMax = 1.0;
     float wMin = .5;
     float weight = wMax -
     (((wMax - wMin)/parameters.numberOfGenerations) * iteration);
     
-    
+    std::vector<int> learners;
     for(int i=0;i<population.size();i++){
-        MMKPSolution* currentSol = &population[i];
-        MMKPSolution tempSol = *currentSol;
-        int randSol = rand() % population.size();
-        MMKPSolution* otherSol = &population[randSol];
+        learners.push_back(i);
+    }
+    
+    MMKP_TLBO::updateLearners(population,learners,
+                              [&](int i,MMKPSolution& tempSol,
+                                  MMKPRandom& rng,
+                                  int& funcEvals){
+        const MMKPSolution* currentSol = &population[i];
+        int randSol = rng.nextInt(population.size());
+        const MMKPSolution* otherSol = &population[randSol];
         
         //if they are the same, skip
-        if(currentSol == otherSol){continue;}
+        if(currentSol == otherSol){return false;}
         
         //if P_k costs less than P_i
         if((*otherSol).getProfit() > (*currentSol).getProfit()){
             //then P_new = P_i+r(P_k-P_i)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil(weight*((*currentSol)[j].at(k)+
                                     (r*((*otherSol)[j].at(k)-(*currentSol)[j].at(k)))));
                     if(diff<=0){
@@ -626,6 +722,7 @@ void MMKP_TLBO::learningPhase_Orthognal(std::vector<MMKPSolution>& population,
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
+                    funcEvals++;
                 }
             }
             //else
@@ -633,7 +730,7 @@ void MMKP_TLBO::learningPhase_Orthognal(std::vector<MMKPSolution>& population,
             //then P_new = P_i+r(P_i-P_k)
             for(int j=0;j<(*currentSol).size();j++){
                 for(int k=0;k<(*currentSol)[j].size();k++){
-                    int r = rand()%2;
+                    int r = rng.nextInt(2);
                     int diff = ceil(weight*((*currentSol)[j].at(k)+
                                     (r*((*currentSol)[j].at(k)-(*otherSol)[j].at(k)))));
                     if(diff<=0){
@@ -641,13 +738,10 @@ void MMKP_TLBO::learningPhase_Orthognal(std::vector<MMKPSolution>& population,
                     }else{
                         (tempSol)[j].at(k) = true;
                     }
+                    funcEvals++;
                 }
             }
         }
-        dataSet.updateSolution(tempSol);
-        MMKP_MetaHeuristic::makeFeasible(tempSol);
-        MMKP_MetaHeuristic::competitiveUpdateSol(*currentSol,tempSol);
-    }
+        return true;
+    });
 }
-
-
@@ -43,22 +43,38 @@
 #include <algorithm> //for "random shuffle"
 #include <random>
 #include <queue>
+#include <functional>
+#include <memory>
 
 #include "MMKP_MetaHeuristic.h"
 #include "MMKPSolution.h"
+#include "MMKPBitSolution.h"
 #include "MMKPDataSet.h"
 #include "MMKP_LocalSearch.h"
+#include "ThreadPool.h"
 
 /**
- * Parameters for customizing the TLBO algorithm.
+ * Parameters for customizing the TLBO algorithm. numberOfThreads other
+ * than 1 enables the parallel mode (see MMKP_TLBO::updateLearners), 0
+ * uses every core.
  */
 class TLBO_parameters:public MetaHeuristic_parameters{
 public:
     int alg_Type;
     int rls_on;
-    TLBO_parameters():alg_Type(0),rls_on(0){}
+    int numberOfThreads;
+    TLBO_parameters():alg_Type(0),rls_on(0),numberOfThreads(1){}
 };
 
+/**
+ * Builds the new candidate of learner (population index) param: learner
+ * into param: tempSol, a copy of the learner. Random numbers must be taken
+ * from param: rng and function evaluations added to param: funcEvals.
+ * Return false to skip the learner.
+ */
+typedef std::function<bool(int learner, MMKPSolution& tempSol,
+                           MMKPRandom& rng, int& funcEvals)> TLBO_candidate;
+
 /**
  * Teaching-learning-based optimization algrithm for the 
  * multiple-choice, multiple-dimensional knapsack problem.
@@ -66,6 +82,21 @@ public:
 class MMKP_TLBO:public MMKP_MetaHeuristic{
 private:
     TLBO_parameters parameters;
+    std::shared_ptr<ThreadPool> pool;
+    
+    /**
+     * Build a candidate for each of param: learners, make it feasible and
+     * keep it if better (competitiveUpdateSol). Sequentially, learners are
+     * updated one after another using rng. In parallel mode candidates
+     * are built and made feasible concurrently, all from the population as
+     * it is at the start of the call and each with its own stream split
+     * from rng, then committed in learner order, so the result does not
+     * depend on the number of threads. Learners not reached before the
+     * time or evaluation budget runs out are left unchanged.
+     */
+    void updateLearners(std::vector<MMKPSolution>& population,
+                        const std::vector<int>& learners,
+                        const TLBO_candidate& candidate);
 public:
     /**
      * Construct MMKP_TLBO object. Param: parameters can customize
@@ -14,15 +14,18 @@
 #include <iostream>
 #include <stdlib.h> //atoi
 #include <time.h>
+#include <chrono>
 #include <iomanip>
-#include <random>
 
 #include "MMKPDataSet.h"
+#include "MMKPBinary.h"
+#include "MMKPReduction.h"
 #include "MMKPSolution.h"
 #include "MMKP_TLBO.h"
 #include "MMKP_COA.h"
 #include "MMKP_GA.h"
 #include "MMKPPopulationGenerators.h"
+#include "MMKPRandom.h"
 
 bool doesContain(std::vector<MMKPSolution> population,MMKPSolution sol);
 
@@ -33,7 +36,8 @@ int main(int argc, char* argv[]){
     int problem = 1;
     int popSize = 30;
     int genSize = 40;
-    unsigned int seed = 1234;
+    unsigned long long seed = 0;
+    int numberOfThreads = 1;
     std::string mods = "";
     
     if(argc==7){
@@ -43,56 +47,98 @@ int main(int argc, char* argv[]){
         mods = argv[4];
         popSize = atoi(argv[5]);
         genSize = atoi(argv[6]);
-    }else if(argc==8){
+    }else if((argc==8) || (argc==9)){
         folder = argv[1];
         file = argv[2];
         problem = atoi(argv[3]);
         mods = argv[4];
         popSize = atoi(argv[5]);
         genSize = atoi(argv[6]);
-        seed = atoi(argv[7]);
+        seed = strtoull(argv[7],NULL,10);
+        if(argc==9){
+            numberOfThreads = atoi(argv[8]);
+        }
     }else{
-        std::cout<<"usage: filename <folder><name><number><popSize><genSize>\n";
+        std::cout<<"usage: filename <folder><name><number><mods><popSize>"
+            <<"<genSize>[<seed>[<threads>]]\n";
         return 0;
     }
     
     std::ifstream fileStream;
     MMKPDataSet dataSet;
-    clock_t t1,t2;
+    //wall clock time, clock() would add up the time of every thread
+    std::chrono::steady_clock::time_point t1,t2;
     float runtime;
-    fileStream.open(folder+std::string("/")+file);
     
     /* READ INPUT */
-    if(fileStream.is_open()){
-        //build MMKPDataSet object
-        if(folder=="orlib_data"){
-            OrLib_Read readInput;
-            dataSet = readInput(fileStream);
-        }else if(folder=="HiremathHill_data"){
-            HiremathHill_Read readInput;
-            dataSet = readInput(fileStream,problem);
+    //use a converted binary file (see MMKPConvert) when there is one
+    MMKPBinary_Read readBinary;
+    dataSet = readBinary(folder+std::string("/")+file+MMKP_BINARY_EXTENSION,
+                         problem);
+    if(dataSet.size()==0){
+        fileStream.open(folder+std::string("/")+file);
+        if(fileStream.is_open()){
+            //build MMKPDataSet object
+            if(folder=="orlib_data"){
+                OrLib_Read readInput;
+                dataSet = readInput(fileStream);
+            }else if(folder=="HiremathHill_data"){
+                HiremathHill_Read readInput;
+                dataSet = readInput(fileStream,problem,
+                                    folder+std::string("/")+file);
+            }else{
+                std::cout<<"Error, unrecognized folder name."<<std::endl;
+            }
         }else{
-            std::cout<<"Error, unrecognized folder name."<<std::endl;
+            std::cerr<<std::string("File ")+file+std::string(" failed to open.")
+            <<std::endl;
         }
-    }else{
-        std::cerr<<std::string("File ")+file+std::string(" failed to open.")
-        <<std::endl;
+        fileStream.close();
     }
-    fileStream.close();
+    
+    //optional fifth modification, 1 = run on the reduced problem
+    MMKPReduction* reduction = NULL;
+    if((mods.size() > 4) && ((mods[4] - '0') == 1) && (dataSet.size() != 0)){
+        reduction = new MMKPReduction(dataSet);
+        std::cerr<<reduction->getStats()<<std::endl;
+        dataSet = reduction->getReducedDataSet();
+    }
+    
+    //every random choice is drawn from seed (0 = seed from random_device)
+    MMKPRandom rng((seed != 0) ? seed : MMKPRandom::randomSeed());
     
     //generate initial population
-    GenerateRandomizedPopulationNoDups generatePopulation;
+    GenerateRandomizedPopulationNoDups generatePopulation(rng());
     std::vector<MMKPSolution> population
     = generatePopulation(dataSet,popSize);
     
     //algs used
-    MMKP_TLBO tlbo(dataSet);
-    MMKP_COA coa(dataSet);
-    MMKP_GA ga(dataSet);
+    TLBO_parameters tlboParameters;
+    tlboParameters.seed = rng();
+    COA_parameters coaParameters;
+    coaParameters.seed = rng();
+    GA_parameters gaParameters;
+    gaParameters.seed = rng();
+    MMKP_TLBO tlbo(dataSet,tlboParameters);
+    
+    //elite solutions are polished in parallel (1 = one after another)
+    std::shared_ptr<ThreadPool> pool;
+    if(numberOfThreads != 1){
+        pool.reset(new ThreadPool(numberOfThreads));
+    }
+    MMKP_COA coa(dataSet,coaParameters);
+    MMKP_GA ga(dataSet,gaParameters);
 
-    tlbo.quickSort(population,0,population.size()-1);
+    //elites are the best feasible solutions, so rank only the best
+    //eliteRankSize (new elites and the ones already kept), and the rest
+    //when infeasible solutions crowd them out
+    int eliteSolutionSize = 5;
+    int eliteRankSize = 2*(eliteSolutionSize+1);
+    
+    tlbo.sortPopulationTop(population,eliteRankSize);
     MMKPSolution optimalSolution;
     for(int i=0;i<population.size();i++){
+        if(i == eliteRankSize){tlbo.sortPopulation(population);}
         if(dataSet.isFeasible(population[i])){
             optimalSolution = population[i];
             break;
@@ -100,16 +146,14 @@ int main(int argc, char* argv[]){
     }
     MMKPSolution initialTeacher = optimalSolution;
     
-    t1=clock();
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    t1 = std::chrono::steady_clock::now();
     std::uniform_int_distribution<> dis(0, 2);
     
-    int eliteSolutionSize = 5;
     std::vector<MMKPSolution> eliteSolutions;
     
     int count = 0;
     for(int i=0;i<population.size();i++){
+        if(i == eliteRankSize){tlbo.sortPopulation(population);}
         dataSet.updateSolution(population[i]);
         if(dataSet.isFeasible(population[i])){
             eliteSolutions.push_back(population[i]);
@@ -131,7 +175,7 @@ int main(int argc, char* argv[]){
         std::vector<MMKPSolution> pop3;
         
         for(int j=0;j<population.size();j++){
-            int p = dis(gen);
+            int p = dis(rng);
             switch(p){
                 case 0:
                     pop1.push_back(population[j]);
@@ -147,9 +191,9 @@ int main(int argc, char* argv[]){
     
         //replace worse 3 solutions of each population with
         //elite solutions
-        tlbo.quickSort(pop1,0,pop1.size()-1);
-        tlbo.quickSort(pop2,0,pop2.size()-1);
-        tlbo.quickSort(pop3,0,pop3.size()-1);
+        tlbo.sortPopulation(pop1);
+        tlbo.sortPopulation(pop2);
+        tlbo.sortPopulation(pop3);
         
         for(int j=0;j<eliteSolutions.size();j++){
             pop1[((pop1.size()-1)-j)] = eliteSolutions[j];
@@ -173,8 +217,9 @@ int main(int argc, char* argv[]){
         //get and save best solution
         //and update our elite list
         count = 0;
-        tlbo.quickSort(population,0,population.size()-1);
+        tlbo.sortPopulationTop(population,eliteRankSize);
         for(int j=0;j<population.size();j++){
+            if(j == eliteRankSize){tlbo.sortPopulation(population);}
             dataSet.updateSolution(population[j]);
             if(dataSet.isFeasible(population[j])){
                 if(population[j].getProfit()
@@ -191,7 +236,8 @@ int main(int argc, char* argv[]){
                 }
             }
         }
-        ReactiveLocalSearch RLS(dataSet);
+        ReactiveLocalSearch RLS(dataSet,rng.split());
+        RLS.setThreadPool(pool);
         //run local search on elite solutions
         eliteSolutions = RLS(eliteSolutions);
         
@@ -200,9 +246,18 @@ int main(int argc, char* argv[]){
         convData.push_back(temp);
     }
     
-    t2 = clock();
+    t2 = std::chrono::steady_clock::now();
     
-    runtime = ((float)t2-(float)t1)/(double) CLOCKS_PER_SEC;
+    runtime = std::chrono::duration<double>(t2-t1).count();
+    
+    //report the items of the original problem
+    if(reduction != NULL){
+        if(optimalSolution.size() == dataSet.size()){
+            optimalSolution = reduction->expand(optimalSolution);
+        }
+        dataSet = reduction->getOriginalDataSet();
+        delete reduction;
+    }
     
     std::cout<<"Problem: "<<std::endl;
     std::cout<<folder<<std::string("/")<<file<<std::endl;
@@ -0,0 +1,121 @@
+/*********************************************************
+ *
+ * File: SpscQueue.h
+ * Author: Ken Zyma
+ *
+ * Bounded single producer, single consumer lock-free queue.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____SpscQueue__
+#define ____SpscQueue__
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <assert.h>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Elements are kept in a ring buffer of fixed capacity, push and
+ * pop never block and never allocate. The head (consumer) and tail
+ * (producer) indices are padded onto separate cache lines so the two
+ * threads do not contend.
+ */
+template<typename T>
+class SpscQueue{
+    
+private:
+    static const std::size_t CACHE_LINE = 64;
+    
+    std::vector<T> buffer;
+    std::size_t mask;
+    char padBuffer[CACHE_LINE];
+    std::atomic<std::size_t> head;
+    char padHead[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> tail;
+    char padTail[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+    
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+public:
+    /**
+     * Construct SpscQueue holding at least param: capacity elements, the
+     * capacity is rounded up to a power of two.
+     */
+    explicit SpscQueue(std::size_t capacity):head(0),tail(0){
+        assert(capacity > 0);
+        std::size_t size = 1;
+        while(size < capacity){size <<= 1;}
+        this->buffer.resize(size);
+        this->mask = size-1;
+    }
+    
+    /**
+     * Return number of elements the queue can hold.
+     */
+    std::size_t capacity() const{
+        return this->buffer.size();
+    }
+    
+    /**
+     * Append a copy of param: value. Return false, leaving the queue
+     * unchanged, if it is full. Producer thread only.
+     */
+    bool push(const T& value){
+        const std::size_t t = this->tail.load(std::memory_order_relaxed);
+        if(t - this->head.load(std::memory_order_acquire) == this->buffer.size()){
+            return false;
+        }
+        this->buffer[t & this->mask] = value;
+        this->tail.store(t+1,std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Move the oldest element into param: value. Return false if the queue
+     * is empty. Consumer thread only.
+     */
+    bool pop(T& value){
+        const std::size_t h = this->head.load(std::memory_order_relaxed);
+        if(h == this->tail.load(std::memory_order_acquire)){
+            return false;
+        }
+        value = std::move(this->buffer[h & this->mask]);
+        this->head.store(h+1,std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Return true if the queue is empty. Exact only when called from the
+     * consumer thread.
+     */
+    bool empty() const{
+        return (this->head.load(std::memory_order_acquire) ==
+                this->tail.load(std::memory_order_acquire));
+    }
+};
+
+#endif /* defined(____SpscQueue__) */
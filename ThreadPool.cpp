@@ -0,0 +1,111 @@
+/*********************************************************
+ *
+ * File: ThreadPool.cpp
+ * Author: Ken Zyma
+ *
+ * @All rights reserved
+ * Kutztown University, PA, U.S.A
+ *
+ * Implementation of ThreadPool
+ *
+ *********************************************************/
+
+#include "ThreadPool.h"
+
+/* ThreadPool */
+
+ThreadPool::ThreadPool(int numberOfThreads):task(NULL),taskCount(0),
+nextIndex(0),activeWorkers(0),generation(0),isStopping(false){
+    if(numberOfThreads < 1){
+        numberOfThreads = std::thread::hardware_concurrency();
+        if(numberOfThreads < 1){numberOfThreads = 1;}
+    }
+    for(int i=0;i<numberOfThreads-1;i++){
+        this->workers.push_back(std::thread(&ThreadPool::workerLoop,this));
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->isStopping = true;
+    }
+    this->workReady.notify_all();
+    for(std::size_t i=0;i<this->workers.size();i++){
+        this->workers[i].join();
+    }
+}
+
+int ThreadPool::size() const{
+    return this->workers.size()+1;
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task){
+    if(count <= 0){return;}
+    if(this->workers.empty() || (count == 1)){
+        for(int i=0;i<count;i++){
+            task(i);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = &task;
+        this->taskCount = count;
+        this->nextIndex = 0;
+        this->activeWorkers = this->workers.size();
+        this->error = std::exception_ptr();
+        this->generation++;
+    }
+    this->workReady.notify_all();
+    
+    //calling thread takes part
+    ThreadPool::runTasks();
+    
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->workDone.wait(lock,[this](){return this->activeWorkers == 0;});
+    this->task = NULL;
+    if(this->error){
+        std::exception_ptr e = this->error;
+        this->error = std::exception_ptr();
+        std::rethrow_exception(e);
+    }
+}
+
+void ThreadPool::workerLoop(){
+    unsigned long long seenGeneration = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->workReady.wait(lock,[&](){
+                return this->isStopping || (this->generation != seenGeneration);
+            });
+            if(this->isStopping){return;}
+            seenGeneration = this->generation;
+        }
+        ThreadPool::runTasks();
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->activeWorkers--;
+            if(this->activeWorkers == 0){
+                this->workDone.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runTasks(){
+    while(true){
+        int i = this->nextIndex.fetch_add(1);
+        if(i >= this->taskCount){return;}
+        try{
+            (*this->task)(i);
+        }catch(...){
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if(!this->error){
+                this->error = std::current_exception();
+            }
+        }
+    }
+}
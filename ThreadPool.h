@@ -0,0 +1,102 @@
+/*********************************************************
+ *
+ * File: ThreadPool.h
+ * Author: Ken Zyma
+ *
+ * Fixed size thread pool for data parallel loops.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) [2015] [Kutztown University]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *********************************************************/
+
+#ifndef ____ThreadPool__
+#define ____ThreadPool__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+
+/**
+ * Fixed size pool of worker threads for data parallel loops. Workers are
+ * started once and reused by every call to parallelFor.
+ */
+class ThreadPool{
+    
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    const std::function<void(int)>* task;
+    int taskCount;
+    std::atomic<int> nextIndex;
+    int activeWorkers;
+    unsigned long long generation;
+    bool isStopping;
+    std::exception_ptr error;
+    
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+    
+    /**
+     * Worker thread main loop.
+     */
+    void workerLoop();
+    
+    /**
+     * Run task on indices taken from nextIndex until all are taken.
+     */
+    void runTasks();
+public:
+    /**
+     * Construct ThreadPool. Param: numberOfThreads is the total number of
+     * threads used by parallelFor, including the calling thread, so
+     * numberOfThreads-1 workers are started. Values below 1 use the number
+     * of hardware threads.
+     */
+    explicit ThreadPool(int numberOfThreads);
+    
+    /**
+     * Stop and join all workers.
+     */
+    ~ThreadPool();
+    
+    /**
+     * Return number of threads used by parallelFor.
+     */
+    int size() const;
+    
+    /**
+     * Call task(i) for every i in [0, count), spread over the pool, and
+     * return once all calls have finished. The order of the calls is not
+     * specified. If a call throws, the first exception is rethrown here
+     * after the remaining calls finish. Not reentrant.
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+};
+
+#endif /* defined(____ThreadPool__) */
@@ -14,8 +14,16 @@
 
 import itertools
 
+'''
+THREADS:
+1: ants are built one after another
+>1: ants are built in parallel, on this many threads
+0: ants are built in parallel, on every core
+'''
+
 B=25.0
 p=0.98
 e=0.005
+THREADS = 1
 
     
@@ -251,7 +251,8 @@ def run(alg):
                     paramStr = ''
                     
                     if alg == 'tlbo':
-                        paramStr = str(TlboSettings.ALG_TYPE)+' '+str(TlboSettings.RLS_ON)
+                        paramStr = str(TlboSettings.ALG_TYPE)+' '+str(TlboSettings.RLS_ON)+\
+                            ' '+str(TlboSettings.THREADS)
                     elif alg == 'coa':
                         paramStr = str(CoaSettings.V_PROB)+' '+str(CoaSettings.H_PROB)
                     elif alg == 'ga':
@@ -259,7 +260,8 @@ def run(alg):
                     elif alg == 'bba':
                         pass
                     elif alg == 'aco':
-                        paramStr = str(AcoSettings.B)+' '+str(AcoSettings.p)+' '+str(AcoSettings.e)
+                        paramStr = str(AcoSettings.B)+' '+str(AcoSettings.p)+' '+str(AcoSettings.e)+\
+                            ' '+str(AcoSettings.THREADS)
                     elif alg == 'mmhph':
                         execStr = './MmhphApp'
                     elif alg == 'pso':
@@ -80,6 +80,12 @@ MOD1 : Popululation creation
     currently validate that more solutions exist than the size of population being 
     generated. This case could cuase an infinite loop, however, will never occur
     in any of the benchmark problems currently supported.
+2 = Same as 1, however solutions may violate multiple dimension feasibility.
+3 = Generate a population greedily, each solution picks the best item of
+    every class by one of 5 randomly chosen surrogate functions.
+4 = Generate a feasible, randomized population constructively. Each class
+    picks a random item among those that still fit, leaving room for the
+    classes after it, so no solutions are thrown away. No repeated solutions.
 
 MOD2 : Modification's to regain Multiple Choice Feasibility
 0 = select based on surrogate resource/profit. If no items in a
@@ -105,20 +111,28 @@ MOD 3 = Modifications to regain Multidimensional Feasbilitiy
     becuase it attempts to keep a high profit solution.
 4 = Randomly choose between 0 and 2 each time function is invoked.
 5 = do nothing
+6 = Repeatedly apply the item swap that frees the most violated resources
+    per unit of profit lost, kept in a heap of the best swap of each class.
 
 MOD 4 = Local search added AFTER the heuristic is ran.
 0 = OFF
 1 = Complementary Local Search is added
 2 = Reactive Local Search is added
+
+MOD 5 = Problem reduction before the heuristic is ran.
+0 = OFF
+1 = Remove items dominated within their class and items that can never fit,
+    the solution is reported with the items of the original problem.
 '''
 MOD1 = ['1']
 MOD2 = ['2']
 MOD3 = ['1']
 MOD4 = ['0']
-MOD_LIST = [MOD1,MOD2,MOD3,MOD4]
+MOD5 = ['0']
+MOD_LIST = [MOD1,MOD2,MOD3,MOD4,MOD5]
 MODS = []
 
-MODIFIER = MOD1[0]+MOD2[0]+MOD3[0]+MOD4[0]
+MODIFIER = MOD1[0]+MOD2[0]+MOD3[0]+MOD4[0]+MOD5[0]
 
 
 
@@ -30,7 +30,13 @@ population size.
 RLS_ON:
 0: no reactive local search on teacher's
 1: reactive local serach on teachers
+
+THREADS:
+1: learners are updated one after another
+>1: learners are updated in parallel, on this many threads
+0: learners are updated in parallel, on every core
 '''
 
 ALG_TYPE = 3
 RLS_ON = 1
+THREADS = 1